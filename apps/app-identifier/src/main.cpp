@@ -6,9 +6,64 @@
 #include <QCommandLineOption>
 #include <QCommandLineParser>
 #include <QDBusMessage>
+#include <QDBusMetaType>
 
 #include "global.h"
 
+namespace {
+int identifyMany(QDBusConnection &con, const QList<pid_t> &PIDList)
+{
+    qDBusRegisterMetaType<IdentifyResult>();
+    qDBusRegisterMetaType<QList<IdentifyResult>>();
+    qDBusRegisterMetaType<QList<QDBusUnixFileDescriptor>>();
+
+    QList<pid_t> opened;
+    QList<QDBusUnixFileDescriptor> pidfds;
+    for (auto pid : PIDList) {
+        auto pidfd = pidfd_open(pid, 0);
+        if (pidfd == -1) {
+            qCritical() << "failed to open pidfd of" << pid << ":" << std::strerror(errno) << "skip.";
+            continue;
+        }
+
+        opened.append(pid);
+        pidfds.append(QDBusUnixFileDescriptor{pidfd});
+        // see QDBusUnixFileDescriptor: The original file descriptor is not touched and must be closed by the user.
+        close(pidfd);
+    }
+
+    if (pidfds.isEmpty()) {
+        return 0;
+    }
+
+    using namespace Qt::StringLiterals;
+    auto msg = QDBusMessage::createMethodCall(fromStaticRaw(DDEApplicationManager1ServiceName),
+                                              fromStaticRaw(DDEApplicationManager1ObjectPath),
+                                              fromStaticRaw(ApplicationManager1Interface),
+                                              u"IdentifyMany"_s);
+    msg.setArguments({QVariant::fromValue(pidfds)});
+
+    auto reply = con.call(msg);
+    if (reply.type() != QDBusMessage::ReplyMessage) {
+        qWarning() << "failed to Identify processes" << opened << reply.errorMessage();
+        return 0;
+    }
+
+    const auto results = qdbus_cast<QList<IdentifyResult>>(reply.arguments().constFirst());
+    for (qsizetype i = 0; i < results.size() && i < opened.size(); ++i) {
+        const auto &result = results.at(i);
+        if (!result.applicationId.isEmpty()) {
+            qInfo() << "The capacity of process" << opened.at(i) << "is:" << result.applicationId;
+            continue;
+        }
+
+        qWarning() << "failed to get appID of process" << opened.at(i) << result.error;
+    }
+
+    return 0;
+}
+}  // namespace
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app{argc, argv};
@@ -41,6 +96,10 @@ int main(int argc, char *argv[])
     });
 
     auto con = QDBusConnection::sessionBus();
+    if (PIDList.size() > 1) {
+        return identifyMany(con, PIDList);
+    }
+
     std::for_each(PIDList.cbegin(), PIDList.cend(), [&con](pid_t pid) {
         auto pidfd = pidfd_open(pid, 0);
         if (pidfd == -1) {
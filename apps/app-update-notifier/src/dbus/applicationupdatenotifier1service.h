@@ -6,10 +6,13 @@
 #define APPLICATIONUPDATENOTIFIER1SERVICE_H
 
 #include <QObject>
+#include <QStringList>
 
 constexpr auto NotifierServiceName = "org.desktopspec.ApplicationUpdateNotifier1";
 constexpr auto NotifierObjectPath = "/org/desktopspec/ApplicationUpdateNotifier1";
 constexpr auto NotifierInterfaceName = "org.desktopspec.ApplicationUpdateNotifier1";
+// written by the dpkg post-invoke hook, one path per line
+constexpr auto ChangedApplicationsFile = "/run/dde-application-manager/dpkg-changed-applications";
 
 class ApplicationUpdateNotifier1Service : public QObject
 {
@@ -19,6 +22,7 @@ public:
     ~ApplicationUpdateNotifier1Service() override = default;
 Q_SIGNALS:
     void ApplicationUpdated();
+    void ApplicationFilesUpdated(const QStringList &paths);
 };
 
 #endif
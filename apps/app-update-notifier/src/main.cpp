@@ -3,10 +3,37 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "dbus/applicationupdatenotifier1service.h"
+#include <QFile>
+#include <optional>
+
+namespace {
+std::optional<QStringList> changedApplications()
+{
+    QFile file{QString::fromLatin1(ChangedApplicationsFile)};
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        return std::nullopt;
+    }
+
+    QStringList paths;
+    while (!file.atEnd()) {
+        auto path = QString::fromLocal8Bit(file.readLine()).trimmed();
+        if (!path.isEmpty()) {
+            paths.append(std::move(path));
+        }
+    }
+    return paths;
+}
+}  // namespace
 
 int main()
 {
+    // the hook removes the list once we are gone, read it before the name is taken
+    auto paths = changedApplications();
     ApplicationUpdateNotifier1Service service;
-    emit service.ApplicationUpdated();
+    if (paths) {
+        emit service.ApplicationFilesUpdated(*paths);
+    } else {
+        emit service.ApplicationUpdated();
+    }
     return 0;
 }
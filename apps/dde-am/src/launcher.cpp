@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "launcher.h"
+#include "applicationindex.h"
 #include "global.h"
 
 #include <DConfig>
@@ -60,6 +61,12 @@ ObjectMap getManagedObjects()
 
 DExpected<QStringList> Launcher::appIds()
 {
+    // read the index published by application manager, fall back to D-Bus if it's missing, outdated
+    // or left behind by a daemon which isn't running any more.
+    if (ApplicationIndexReader index; index.open() && index.isLive()) {
+        return index.ids();
+    }
+
     QStringList appIds;
     const auto objects = getManagedObjects();
     for (auto iter = objects.cbegin(); iter != objects.cend(); ++iter) {
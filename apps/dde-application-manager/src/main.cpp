@@ -30,6 +30,9 @@ void registerComplexDbusType()
     qDBusRegisterMetaType<QList<SystemdProperty>>();
     qDBusRegisterMetaType<SystemdAux>();
     qDBusRegisterMetaType<QList<SystemdAux>>();
+    qDBusRegisterMetaType<IdentifyResult>();
+    qDBusRegisterMetaType<QList<IdentifyResult>>();
+    qDBusRegisterMetaType<QList<QDBusUnixFileDescriptor>>();
 }
 }  // namespace
 
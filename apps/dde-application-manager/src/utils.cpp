@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "global.h"
+#include <QDBusVirtualObject>
 
 bool registerObjectToDBus(QObject *o, const QString &path, const QString &interface) noexcept
 {
@@ -22,6 +23,24 @@ bool registerObjectToDBus(QObject *o, const QString &path, const QString &interf
     return true;
 }
 
+bool registerVirtualObjectToDBus(QDBusVirtualObject *o, const QString &path) noexcept
+{
+    if (o == nullptr) {
+        qCCritical(DDEAMUtils) << "Attempted to register a null virtual object to" << path;
+        return false;
+    }
+
+    auto &con = ApplicationManager1DBus::instance().globalServerBus();
+    if (!con.registerVirtualObject(path, o, QDBusConnection::VirtualObjectRegisterOption::SingleNode)) {
+        qCCritical(DDEAMUtils) << "Register virtual object failed!"
+                               << "Path:" << path << "Error:" << con.lastError().message();
+        return false;
+    }
+
+    qCDebug(DDEAMUtils) << "Virtual object registered successfully at" << path;
+    return true;
+}
+
 void unregisterObjectFromDBus(const QString &path) noexcept
 {
     auto &con = ApplicationManager1DBus::instance().globalServerBus();
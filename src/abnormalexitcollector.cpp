@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "abnormalexitcollector.h"
+#include "eventreporter.h"
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QFuture>
+#include <QLoggingCategory>
+#include <QStringList>
+#include <QtConcurrentRun>
+#include <memory>
+#include <syslog.h>
+#include <systemd/sd-journal.h>
+
+Q_LOGGING_CATEGORY(amAbnormalExit, "dde.am.abnormal.exit")
+
+AbnormalExitCollector &AbnormalExitCollector::instance()
+{
+    static AbnormalExitCollector collector;
+    return collector;
+}
+
+AbnormalExitCollector::AbnormalExitCollector()
+{
+    // crash storms shouldn't occupy more than one thread
+    m_pool.setMaxThreadCount(1);
+}
+
+bool AbnormalExitCollector::acquire(const QString &appId, qint64 now) noexcept
+{
+    auto &window = m_rateWindows[appId];
+    if (now - window.start >= kRateWindowMs) {
+        window = {now, 0};
+    }
+
+    if (window.count >= kMaxReportsPerWindow) {
+        return false;
+    }
+
+    ++window.count;
+    return true;
+}
+
+void AbnormalExitCollector::collect(AbnormalExit exit) noexcept
+{
+#ifndef HAVE_DDE_API_EVENTLOGGER
+    // nothing would be reported
+    Q_UNUSED(exit)
+#else
+    if (EventReporter::instance().shouldSkip(exit.appId)) {
+        return;
+    }
+
+    if (!acquire(exit.appId, QDateTime::currentMSecsSinceEpoch())) {
+        qCInfo(amAbnormalExit) << "too many abnormal exits of" << exit.appId << ", drop report of" << exit.unitName;
+        return;
+    }
+
+    QtConcurrent::run(&m_pool, [unitName = exit.unitName]() {
+        return readUnitJournal(unitName, kMaxLogLines, kJournalTimeoutMs);
+    }).then(this, [exit = std::move(exit)](const QString &logInfo) {
+        EventReporter::instance().reportAppAbnormalExit(
+            exit.appId, exit.launchType, exit.unitName, logInfo, exit.isLinglong, exit.instanceId);
+    });
+#endif
+}
+
+QString AbnormalExitCollector::readUnitJournal(const QString &unitName, int maxLines, qint64 timeoutMs) noexcept
+{
+    sd_journal *journal{nullptr};
+    // output of user units lands in the journal of the user, which SD_JOURNAL_LOCAL_ONLY may not cover
+    if (auto ret = sd_journal_open(&journal, SD_JOURNAL_CURRENT_USER); ret < 0) {
+        qCWarning(amAbnormalExit) << "failed to open journal:" << strerror(-ret);
+        return {};
+    }
+    std::unique_ptr<sd_journal, decltype(&sd_journal_close)> guard{journal, sd_journal_close};
+
+    const auto unit = unitName.toUtf8();
+    auto addMatch = [journal](const QByteArray &match) {
+        return sd_journal_add_match(journal, match.constData(), static_cast<size_t>(match.size())) >= 0;
+    };
+
+    // matches of the same field are OR-ed, different fields are AND-ed, so warnings of the unit itself
+    // are one group, the user manager and systemd-coredump report about it in disjunct groups of their own
+    if (!addMatch(QByteArrayLiteral("_SYSTEMD_USER_UNIT=") + unit)) {
+        return {};
+    }
+    for (int priority = LOG_EMERG; priority <= LOG_WARNING; ++priority) {
+        if (!addMatch(QByteArrayLiteral("PRIORITY=") + QByteArray::number(priority))) {
+            return {};
+        }
+    }
+
+    for (const auto &field : {QByteArrayLiteral("USER_UNIT="), QByteArrayLiteral("COREDUMP_USER_UNIT=")}) {
+        if (sd_journal_add_disjunction(journal) < 0 || !addMatch(field + unit)) {
+            return {};
+        }
+    }
+
+    if (sd_journal_seek_tail(journal) < 0) {
+        return {};
+    }
+
+    constexpr QByteArrayView messageField{"MESSAGE="};
+    QDeadlineTimer deadline{timeoutMs};
+    QStringList lines;
+    while (lines.size() < maxLines && !deadline.hasExpired() && sd_journal_previous(journal) > 0) {
+        const void *data{nullptr};
+        size_t length{0};
+        if (sd_journal_get_data(journal, "MESSAGE", &data, &length) < 0 ||
+            length < static_cast<size_t>(messageField.size())) {
+            continue;
+        }
+
+        const auto *message = static_cast<const char *>(data) + messageField.size();
+        lines.prepend(QString::fromUtf8(message, static_cast<qsizetype>(length) - messageField.size()));
+    }
+
+    if (deadline.hasExpired()) {
+        qCInfo(amAbnormalExit) << "reading journal of" << unitName << "timed out, got" << lines.size() << "lines.";
+    }
+
+    return lines.join(u'\n');
+}
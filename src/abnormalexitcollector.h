@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ABNORMALEXITCOLLECTOR_H
+#define ABNORMALEXITCOLLECTOR_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+struct AbnormalExit
+{
+    QString appId;
+    QString launchType;
+    QString unitName;
+    QString instanceId;
+    bool isLinglong{false};
+};
+
+// Reads the journal of abnormally exited units on a worker thread,
+// then reports them through EventReporter on the thread of collector.
+class AbnormalExitCollector : public QObject
+{
+    Q_OBJECT
+public:
+    static AbnormalExitCollector &instance();
+
+    void collect(AbnormalExit exit) noexcept;
+
+    // latest warning (or more severe) messages of a user unit, oldest first
+    [[nodiscard]] static QString readUnitJournal(const QString &unitName, int maxLines, qint64 timeoutMs) noexcept;
+
+private:
+    AbnormalExitCollector();
+
+    struct RateWindow
+    {
+        qint64 start{0};
+        int count{0};
+    };
+
+    [[nodiscard]] bool acquire(const QString &appId, qint64 now) noexcept;
+
+    QThreadPool m_pool;
+    QHash<QString, RateWindow> m_rateWindows;
+
+    static constexpr int kMaxLogLines = 6;
+    static constexpr qint64 kJournalTimeoutMs = 1'000;
+    static constexpr int kMaxReportsPerWindow = 3;
+    static constexpr qint64 kRateWindowMs = 600'000;  // 10 minutes
+};
+
+#endif
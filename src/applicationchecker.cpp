@@ -5,10 +5,10 @@
 #include "global.h"
 #include "constant.h"
 #include "applicationchecker.h"
+#include "executableindex.h"
 #include "sessionoverrideconfig.h"
 #include <QDir>
 #include <QFileInfo>
-#include <QStandardPaths>
 
 Q_LOGGING_CATEGORY(DDEAMChecker, "dde.am.checker")
 using namespace Qt::StringLiterals;
@@ -86,7 +86,7 @@ bool ApplicationFilter::tryExecCheck(const DesktopEntry &entry, QStringView desk
                 const QFileInfo info{executable};
                 return !(info.exists() && info.isExecutable());
             }
-            return QStandardPaths::findExecutable(executable).isEmpty();
+            return ExecutableIndex::instance().find(executable).isEmpty();
         }
     }
 
@@ -102,7 +102,7 @@ bool ApplicationFilter::tryExecCheck(const DesktopEntry &entry, QStringView desk
             const QFileInfo info{executable};
             return !(info.exists() && info.isExecutable());
         }
-        return QStandardPaths::findExecutable(executable).isEmpty();
+        return ExecutableIndex::instance().find(executable).isEmpty();
     }
 
     return false;
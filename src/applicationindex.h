@@ -0,0 +1,320 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONINDEX_H
+#define APPLICATIONINDEX_H
+
+// Read-only application index published by dde-application-manager under $XDG_RUNTIME_DIR.
+// Clients map the file and read application metadata without any D-Bus round trip.
+// The daemon replaces the whole file by rename(2), so a mapping always sees one consistent generation;
+// reopen the index (or compare generation()) to pick up updates.
+// The header records the daemon which published it, isLive() tells whether that daemon is still running.
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QList>
+#include <QStandardPaths>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+constexpr static auto &ApplicationIndexFileName = u"deepin-application-manager.index";
+constexpr static char ApplicationIndexMagic[4]{'D', 'A', 'M', 'I'};
+constexpr static quint32 ApplicationIndexVersion = 2;
+
+enum ApplicationIndexFlag : quint32 { NoFlag = 0, NoDisplayFlag = 1U << 0 };
+
+// process which published the index, pid alone may be reused by another process
+struct ApplicationIndexOwner
+{
+    char bootId[16];
+    quint32 pid;
+    quint32 reserved;
+    quint64 startTime;  // clock ticks after boot, see proc_pid_stat(5)
+};
+
+struct ApplicationIndexHeader
+{
+    char magic[4];
+    quint32 version;
+    quint64 generation;
+    quint32 count;
+    quint32 recordsOffset;
+    quint32 stringsOffset;
+    quint32 stringsSize;
+    ApplicationIndexOwner owner;
+};
+
+// offset and size of an UTF-8 string inside the string pool
+struct ApplicationIndexString
+{
+    quint32 offset;
+    quint32 size;
+};
+
+// records are sorted by id
+struct ApplicationIndexRecord
+{
+    ApplicationIndexString id;
+    ApplicationIndexString objectPath;
+    ApplicationIndexString name;
+    ApplicationIndexString icon;
+    ApplicationIndexString categories;  // joined by ';'
+    ApplicationIndexString startupWMClass;
+    quint32 flags;
+    quint32 reserved;
+};
+
+static_assert(sizeof(ApplicationIndexHeader) == 64, "layout of ApplicationIndexHeader is part of the index format");
+static_assert(sizeof(ApplicationIndexRecord) == 56, "layout of ApplicationIndexRecord is part of the index format");
+
+struct ApplicationIndexEntry
+{
+    QString id;
+    QString objectPath;
+    QString name;
+    QString icon;
+    QStringList categories;
+    QString startupWMClass;
+    bool noDisplay{false};
+};
+
+inline QString applicationIndexFilePath() noexcept
+{
+    const auto runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    return QDir{runtimeDir}.filePath(QString::fromRawData(reinterpret_cast<const QChar *>(ApplicationIndexFileName),
+                                                          std::size(ApplicationIndexFileName) - 1));
+}
+
+inline std::optional<ApplicationIndexOwner> applicationIndexOwnerOf(pid_t pid) noexcept
+{
+    QFile bootIdFile{QStringLiteral("/proc/sys/kernel/random/boot_id")};
+    if (!bootIdFile.open(QFile::ReadOnly)) {
+        return std::nullopt;
+    }
+    const auto bootId = QUuid::fromString(QLatin1StringView{bootIdFile.readAll().trimmed()});
+    if (bootId.isNull()) {
+        return std::nullopt;
+    }
+
+    QFile statFile{QStringLiteral("/proc/%1/stat").arg(pid)};
+    if (!statFile.open(QFile::ReadOnly)) {
+        return std::nullopt;
+    }
+    // comm may contain spaces, fields after it start from the 3rd one and starttime is the 22nd
+    const auto stat = statFile.readAll();
+    const auto fields = stat.mid(stat.lastIndexOf(')') + 1).simplified().split(' ');
+    if (fields.size() < 20) {
+        return std::nullopt;
+    }
+    bool ok{false};
+    const auto startTime = fields.at(19).toULongLong(&ok);
+    if (!ok) {
+        return std::nullopt;
+    }
+
+    ApplicationIndexOwner owner{};
+    std::memcpy(owner.bootId, bootId.toRfc4122().constData(), sizeof(owner.bootId));
+    owner.pid = static_cast<quint32>(pid);
+    owner.startTime = startTime;
+    return owner;
+}
+
+class ApplicationIndexReader
+{
+public:
+    ApplicationIndexReader() = default;
+    ~ApplicationIndexReader() { close(); }
+    ApplicationIndexReader(const ApplicationIndexReader &) = delete;
+    ApplicationIndexReader &operator=(const ApplicationIndexReader &) = delete;
+    ApplicationIndexReader(ApplicationIndexReader &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+    {
+    }
+    ApplicationIndexReader &operator=(ApplicationIndexReader &&other) noexcept
+    {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+
+    bool open(const QString &filePath = applicationIndexFilePath()) noexcept
+    {
+        close();
+
+        auto fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            return false;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) == -1 || st.st_size < static_cast<off_t>(sizeof(ApplicationIndexHeader))) {
+            ::close(fd);
+            return false;
+        }
+
+        auto *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+
+        m_data = static_cast<const char *>(addr);
+        m_size = static_cast<size_t>(st.st_size);
+        if (!validate()) {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] bool isValid() const noexcept { return m_data != nullptr; }
+    [[nodiscard]] quint64 generation() const noexcept { return isValid() ? header()->generation : 0; }
+    [[nodiscard]] qsizetype size() const noexcept { return isValid() ? static_cast<qsizetype>(header()->count) : 0; }
+
+    // false if the daemon which published the index has exited, e.g. it crashed or the session was restarted
+    [[nodiscard]] bool isLive() const noexcept
+    {
+        if (!isValid()) {
+            return false;
+        }
+
+        const auto &published = header()->owner;
+        const auto running = applicationIndexOwnerOf(static_cast<pid_t>(published.pid));
+        return running && std::memcmp(running->bootId, published.bootId, sizeof(published.bootId)) == 0 &&
+               running->startTime == published.startTime;
+    }
+
+    [[nodiscard]] QString idAt(qsizetype index) const noexcept { return toString(record(index)->id); }
+
+    [[nodiscard]] ApplicationIndexEntry entryAt(qsizetype index) const noexcept
+    {
+        const auto *rec = record(index);
+        ApplicationIndexEntry entry;
+        entry.id = toString(rec->id);
+        entry.objectPath = toString(rec->objectPath);
+        entry.name = toString(rec->name);
+        entry.icon = toString(rec->icon);
+        entry.categories = toString(rec->categories).split(u';', Qt::SkipEmptyParts);
+        entry.startupWMClass = toString(rec->startupWMClass);
+        entry.noDisplay = (rec->flags & NoDisplayFlag) != 0;
+        return entry;
+    }
+
+    [[nodiscard]] std::optional<ApplicationIndexEntry> find(const QString &appId) const noexcept
+    {
+        const auto key = appId.toUtf8();
+        qsizetype low{0};
+        qsizetype high{size()};
+        while (low < high) {
+            const auto mid = low + (high - low) / 2;
+            const auto cmp = compare(record(mid)->id, key);
+            if (cmp == 0) {
+                return entryAt(mid);
+            }
+
+            if (cmp < 0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    [[nodiscard]] QStringList ids() const noexcept
+    {
+        QStringList ret;
+        ret.reserve(size());
+        for (qsizetype i = 0; i < size(); ++i) {
+            ret.append(idAt(i));
+        }
+        return ret;
+    }
+
+private:
+    const char *m_data{nullptr};
+    size_t m_size{0};
+
+    [[nodiscard]] const ApplicationIndexHeader *header() const noexcept
+    {
+        return reinterpret_cast<const ApplicationIndexHeader *>(m_data);
+    }
+
+    [[nodiscard]] const ApplicationIndexRecord *record(qsizetype index) const noexcept
+    {
+        return reinterpret_cast<const ApplicationIndexRecord *>(m_data + header()->recordsOffset) + index;
+    }
+
+    [[nodiscard]] QString toString(const ApplicationIndexString &str) const noexcept
+    {
+        return QString::fromUtf8(m_data + header()->stringsOffset + str.offset, str.size);
+    }
+
+    [[nodiscard]] int compare(const ApplicationIndexString &str, const QByteArray &key) const noexcept
+    {
+        const auto len = std::min<size_t>(str.size, static_cast<size_t>(key.size()));
+        if (auto ret = std::memcmp(m_data + header()->stringsOffset + str.offset, key.constData(), len); ret != 0) {
+            return ret;
+        }
+        return str.size < key.size() ? -1 : (str.size == static_cast<quint32>(key.size()) ? 0 : 1);
+    }
+
+    [[nodiscard]] bool validString(const ApplicationIndexString &str) const noexcept
+    {
+        return static_cast<quint64>(str.offset) + str.size <= header()->stringsSize;
+    }
+
+    [[nodiscard]] bool validate() const noexcept
+    {
+        const auto *head = header();
+        if (std::memcmp(head->magic, ApplicationIndexMagic, sizeof(ApplicationIndexMagic)) != 0 ||
+            head->version != ApplicationIndexVersion) {
+            return false;
+        }
+
+        const auto recordsEnd = static_cast<quint64>(head->recordsOffset) + static_cast<quint64>(head->count) * sizeof(ApplicationIndexRecord);
+        if (head->recordsOffset % alignof(ApplicationIndexRecord) != 0 || recordsEnd > m_size ||
+            static_cast<quint64>(head->stringsOffset) + head->stringsSize > m_size) {
+            return false;
+        }
+
+        for (qsizetype i = 0; i < static_cast<qsizetype>(head->count); ++i) {
+            const auto *rec = record(i);
+            if (!validString(rec->id) || !validString(rec->objectPath) || !validString(rec->name) ||
+                !validString(rec->icon) || !validString(rec->categories) || !validString(rec->startupWMClass)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+#endif
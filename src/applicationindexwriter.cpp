@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationindexwriter.h"
+#include "global.h"
+#include <QSaveFile>
+#include <algorithm>
+#include <unistd.h>
+
+namespace {
+class StringPool
+{
+public:
+    ApplicationIndexString add(const QString &str) noexcept
+    {
+        const auto utf8 = str.toUtf8();
+        ApplicationIndexString ret{static_cast<quint32>(m_data.size()), static_cast<quint32>(utf8.size())};
+        m_data.append(utf8);
+        return ret;
+    }
+
+    [[nodiscard]] const QByteArray &data() const noexcept { return m_data; }
+
+private:
+    QByteArray m_data;
+};
+}  // namespace
+
+QByteArray ApplicationIndexWriter::serialize(QList<ApplicationIndexEntry> entries, quint64 generation) noexcept
+{
+    std::sort(entries.begin(), entries.end(), [](const ApplicationIndexEntry &lhs, const ApplicationIndexEntry &rhs) {
+        return lhs.id.toUtf8() < rhs.id.toUtf8();
+    });
+
+    StringPool pool;
+    QList<ApplicationIndexRecord> records;
+    records.reserve(entries.size());
+    for (const auto &entry : std::as_const(entries)) {
+        ApplicationIndexRecord record{};
+        record.id = pool.add(entry.id);
+        record.objectPath = pool.add(entry.objectPath);
+        record.name = pool.add(entry.name);
+        record.icon = pool.add(entry.icon);
+        record.categories = pool.add(entry.categories.join(u';'));
+        record.startupWMClass = pool.add(entry.startupWMClass);
+        record.flags = entry.noDisplay ? NoDisplayFlag : NoFlag;
+        records.append(record);
+    }
+
+    ApplicationIndexHeader header{};
+    std::memcpy(header.magic, ApplicationIndexMagic, sizeof(ApplicationIndexMagic));
+    header.version = ApplicationIndexVersion;
+    header.generation = generation;
+    header.count = static_cast<quint32>(records.size());
+    header.recordsOffset = sizeof(ApplicationIndexHeader);
+    header.stringsOffset = header.recordsOffset + static_cast<quint32>(records.size() * sizeof(ApplicationIndexRecord));
+    header.stringsSize = static_cast<quint32>(pool.data().size());
+    if (auto owner = applicationIndexOwnerOf(::getpid()); owner) {
+        header.owner = *owner;
+    } else {
+        qCWarning(DDEAMUtils) << "failed to identify current process, clients will not trust the application index.";
+    }
+
+    QByteArray ret;
+    ret.reserve(header.stringsOffset + header.stringsSize);
+    ret.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    ret.append(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(ApplicationIndexRecord));
+    ret.append(pool.data());
+    return ret;
+}
+
+bool ApplicationIndexWriter::publish(const QString &filePath, QList<ApplicationIndexEntry> entries, quint64 generation) noexcept
+{
+    const auto content = serialize(std::move(entries), generation);
+
+    QSaveFile file{filePath};
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(DDEAMUtils) << "failed to open application index" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    if (file.write(content) != content.size()) {
+        qCWarning(DDEAMUtils) << "failed to write application index" << filePath << ":" << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    if (!file.commit()) {
+        qCWarning(DDEAMUtils) << "failed to commit application index" << filePath << ":" << file.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONINDEXWRITER_H
+#define APPLICATIONINDEXWRITER_H
+
+#include "applicationindex.h"
+#include <QByteArray>
+#include <QList>
+
+class ApplicationIndexWriter
+{
+public:
+    ApplicationIndexWriter() = delete;
+
+    [[nodiscard]] static QByteArray serialize(QList<ApplicationIndexEntry> entries, quint64 generation) noexcept;
+    // write to a temporary file and rename it over filePath, readers never see a partial index
+    static bool publish(const QString &filePath, QList<ApplicationIndexEntry> entries, quint64 generation) noexcept;
+};
+
+#endif
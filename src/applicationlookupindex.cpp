@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationlookupindex.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <algorithm>
+
+void ApplicationLookupIndex::insertKey(Postings &postings, const QString &key, const QString &appId) noexcept
+{
+    if (!key.isEmpty()) {
+        postings[key].insert(appId);
+    }
+}
+
+void ApplicationLookupIndex::removeKey(Postings &postings, const QString &key, const QString &appId) noexcept
+{
+    auto posting = postings.find(key);
+    if (posting == postings.end()) {
+        return;
+    }
+
+    posting->remove(appId);
+    if (posting->isEmpty()) {
+        postings.erase(posting);
+    }
+}
+
+QStringList ApplicationLookupIndex::lookup(const Postings &postings, const QString &key) noexcept
+{
+    auto posting = postings.constFind(key);
+    if (posting == postings.cend()) {
+        return {};
+    }
+
+    QStringList ret{posting->cbegin(), posting->cend()};
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+void ApplicationLookupIndex::update(const QString &appId, LookupKeys keys) noexcept
+{
+    remove(appId);
+
+    keys.wmClass = keys.wmClass.toCaseFolded();
+    keys.executables.removeDuplicates();
+    keys.categories.removeDuplicates();
+
+    insertKey(m_wmClasses, keys.wmClass, appId);
+    for (const auto &executable : std::as_const(keys.executables)) {
+        insertKey(m_executables, executable, appId);
+    }
+    for (const auto &category : std::as_const(keys.categories)) {
+        insertKey(m_categories, category, appId);
+    }
+
+    m_keys.insert(appId, std::move(keys));
+}
+
+void ApplicationLookupIndex::remove(const QString &appId) noexcept
+{
+    auto keys = m_keys.find(appId);
+    if (keys == m_keys.end()) {
+        return;
+    }
+
+    removeKey(m_wmClasses, keys->wmClass, appId);
+    for (const auto &executable : std::as_const(keys->executables)) {
+        removeKey(m_executables, executable, appId);
+    }
+    for (const auto &category : std::as_const(keys->categories)) {
+        removeKey(m_categories, category, appId);
+    }
+
+    m_keys.erase(keys);
+}
+
+void ApplicationLookupIndex::clear() noexcept
+{
+    m_wmClasses.clear();
+    m_executables.clear();
+    m_categories.clear();
+    m_keys.clear();
+}
+
+QStringList ApplicationLookupIndex::findByWMClass(const QString &wmClass) const noexcept
+{
+    return lookup(m_wmClasses, wmClass.toCaseFolded());
+}
+
+QStringList ApplicationLookupIndex::findByExecutable(const QString &path) const noexcept
+{
+    auto ret = lookup(m_executables, QDir::cleanPath(path));
+    if (!ret.isEmpty()) {
+        return ret;
+    }
+
+    const auto canonical = QFileInfo{path}.canonicalFilePath();
+    if (canonical.isEmpty()) {
+        return {};
+    }
+
+    return lookup(m_executables, canonical);
+}
+
+QStringList ApplicationLookupIndex::listByCategory(const QString &category) const noexcept
+{
+    return lookup(m_categories, category);
+}
+
+QString ApplicationLookupIndex::programOf(const QStringList &execArgs) noexcept
+{
+    auto it = execArgs.cbegin();
+    if (it != execArgs.cend() && (*it == u"env" || *it == u"/usr/bin/env")) {
+        ++it;
+        while (it != execArgs.cend() && (it->startsWith(u'-') || it->contains(u'='))) {
+            ++it;
+        }
+    }
+
+    return it == execArgs.cend() ? QString{} : *it;
+}
+
+QStringList ApplicationLookupIndex::resolveExecutable(const QString &program, const QStringList &searchPaths) noexcept
+{
+    if (program.isEmpty()) {
+        return {};
+    }
+
+    auto path = QDir::isAbsolutePath(program) ? QDir::cleanPath(program) : QStandardPaths::findExecutable(program, searchPaths);
+    if (path.isEmpty()) {
+        return {};
+    }
+
+    QStringList ret{path};
+    if (auto canonical = QFileInfo{path}.canonicalFilePath(); !canonical.isEmpty() && canonical != path) {
+        ret.append(std::move(canonical));
+    }
+
+    return ret;
+}
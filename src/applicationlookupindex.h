@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONLOOKUPINDEX_H
+#define APPLICATIONLOOKUPINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+struct LookupKeys
+{
+    QString wmClass;
+    QStringList executables;  // absolute paths
+    QStringList categories;
+};
+
+// Reverse indexes which map window and process properties back to applications.
+class ApplicationLookupIndex
+{
+public:
+    ApplicationLookupIndex() = default;
+    ~ApplicationLookupIndex() = default;
+    ApplicationLookupIndex(const ApplicationLookupIndex &) = delete;
+    ApplicationLookupIndex(ApplicationLookupIndex &&) = delete;
+    ApplicationLookupIndex &operator=(const ApplicationLookupIndex &) = delete;
+    ApplicationLookupIndex &operator=(ApplicationLookupIndex &&) = delete;
+
+    void update(const QString &appId, LookupKeys keys) noexcept;
+    void remove(const QString &appId) noexcept;
+    void clear() noexcept;
+    [[nodiscard]] qsizetype size() const noexcept { return m_keys.size(); }
+
+    // WM_CLASS is matched case-insensitively
+    [[nodiscard]] QStringList findByWMClass(const QString &wmClass) const noexcept;
+    // path is also matched after resolving symbolic links, e.g. the target of /proc/<pid>/exe
+    [[nodiscard]] QStringList findByExecutable(const QString &path) const noexcept;
+    [[nodiscard]] QStringList listByCategory(const QString &category) const noexcept;
+
+    // the program of an Exec line, leading env(1) and its assignments are skipped
+    [[nodiscard]] static QString programOf(const QStringList &execArgs) noexcept;
+    // absolute path and canonical path of the program, relative names are looked up in searchPaths
+    [[nodiscard]] static QStringList resolveExecutable(const QString &program, const QStringList &searchPaths) noexcept;
+
+private:
+    using Postings = QHash<QString, QSet<QString>>;
+
+    Postings m_wmClasses;
+    Postings m_executables;
+    Postings m_categories;
+    QHash<QString, LookupKeys> m_keys;
+
+    static void insertKey(Postings &postings, const QString &key, const QString &appId) noexcept;
+    static void removeKey(Postings &postings, const QString &key, const QString &appId) noexcept;
+    [[nodiscard]] static QStringList lookup(const Postings &postings, const QString &key) noexcept;
+};
+
+#endif
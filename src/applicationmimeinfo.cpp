@@ -6,6 +6,7 @@
 #include "constant.h"
 #include "global.h"
 #include <QSaveFile>
+#include <sys/stat.h>
 
 Q_LOGGING_CATEGORY(DDEAMMime, "dde.am.mime")
 
@@ -69,6 +70,8 @@ std::optional<MimeFileBase> MimeFileBase::loadFromFile(const QFileInfo &fileInfo
         return std::nullopt;
     }
 
+    // take the stamp before parsing, a write racing with us will be picked up by the next check
+    const auto stamp = stampOf(filePath);
     MimeContent content;
     MimeFileParser parser{file, desktopSpec};
     if (auto err = parser.parse(content); err != ParserError::NoError) {
@@ -76,17 +79,38 @@ std::optional<MimeFileBase> MimeFileBase::loadFromFile(const QFileInfo &fileInfo
         return std::nullopt;
     }
 
-    return MimeFileBase{fileInfo, std::move(content), desktopSpec, isWritable};
+    return MimeFileBase{fileInfo, std::move(content), desktopSpec, isWritable, stamp};
 }
 
-MimeFileBase::MimeFileBase(const QFileInfo &info, MimeContent &&content, bool desktopSpec, bool writable)
+MimeFileBase::MimeFileBase(const QFileInfo &info, MimeContent &&content, bool desktopSpec, bool writable, FileStamp stamp)
     : m_desktopSpec(desktopSpec)
     , m_writable(writable)
     , m_info(info)
     , m_content(std::move(content))
+    , m_stamp(stamp)
 {
 }
 
+MimeFileBase::FileStamp MimeFileBase::stampOf(const QString &filePath) noexcept
+{
+    struct stat st{};
+    if (::stat(QFile::encodeName(filePath).constData(), &st) == -1) {
+        return {};
+    }
+
+    return {static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec, static_cast<qint64>(st.st_size)};
+}
+
+bool MimeFileBase::isModified() const noexcept
+{
+    return stampOf(m_info.absoluteFilePath()) != m_stamp;
+}
+
+void MimeFileBase::updateStamp() noexcept
+{
+    m_stamp = stampOf(m_info.absoluteFilePath());
+}
+
 void MimeFileBase::reload() noexcept
 {
     auto newBase = MimeFileBase::loadFromFile(fileInfo(), isDesktopSpecific());
@@ -96,6 +120,7 @@ void MimeFileBase::reload() noexcept
     }
 
     m_content = std::move(newBase->m_content);
+    m_stamp = newBase->m_stamp;
 }
 
 MimeApps::MimeApps(MimeFileBase &&base)
@@ -230,60 +255,42 @@ QString MimeApps::queryDefaultApp(const QString &type) const noexcept
     return appView.chopped(desktopSuffix.size()).toString();
 }
 
-QStringList MimeCache::queryTypes(QString appId) const noexcept
+QStringList MimeCache::queryTypes(const QString &appId) const noexcept
 {
-    QStringList ret;
-    appId.append(desktopSuffix);
-    const auto &cache = content()[fromStaticRaw(mimeCache)];  // NOLINT
-    for (const auto &[key, value] : cache.asKeyValueRange()) {
-        if (value.contains(appId)) {
-            ret.append(key);
-        }
+    return m_index->typesOf(appId);
+}
+
+void MimeCache::reload() noexcept
+{
+    auto cache = createMimeCache(fileInfo().absoluteFilePath());
+    if (!cache) {
+        qWarning() << "reload" << fileInfo().absoluteFilePath() << "failed, content wouldn't be changed.";
+        return;
     }
 
-    return ret;
+    *this = std::move(cache).value();
 }
 
 std::optional<MimeCache> MimeCache::createMimeCache(const QString &filePath) noexcept
 {
-    auto baseOpt = MimeFileBase::loadFromFile(QFileInfo{filePath}, false);
-
-    if (!baseOpt) {
+    auto index = MimeCacheIndex::load(filePath);
+    if (!index) {
         return std::nullopt;
     }
 
-    return MimeCache{std::move(baseOpt).value()};
+    const FileStamp stamp{index->sourceMtime(), index->sourceSize()};
+    return MimeCache{QFileInfo{filePath}, stamp, std::move(index)};
 }
 
-MimeCache::MimeCache(MimeFileBase &&base)
-    : MimeFileBase(std::move(base))
+MimeCache::MimeCache(const QFileInfo &info, FileStamp stamp, std::shared_ptr<const MimeCacheIndex> index)
+    : MimeFileBase(info, {}, false, false, stamp)
+    , m_index(std::move(index))
 {
 }
 
 QStringList MimeCache::queryApps(const QString &type) const noexcept
 {
-    const auto &content = this->content();
-    auto it = content.constFind(fromStaticRaw(mimeCache));
-    if (it == content.constEnd()) {
-        qDebug() << "this cache is broken, please reload.";
-        return {};
-    }
-
-    auto kv = it->constFind(type);
-    if (kv == it->constEnd()) {
-        return {};
-    }
-
-    QStringList ret;
-    for (const auto &e : kv.value()) {
-        if (!e.endsWith(desktopSuffix)) {
-            continue;
-        }
-
-        ret.append(e.chopped(desktopSuffix.size()));
-    }
-
-    return ret;
+    return m_index->appsOf(type);
 }
 
 std::optional<MimeInfo> MimeInfo::createMimeInfo(const QString &directory) noexcept
@@ -328,9 +335,35 @@ std::optional<MimeInfo> MimeInfo::createMimeInfo(const QString &directory) noexc
         }
     }
 
+    ret.m_existingFiles = existingFiles(directory);
+    return ret;
+}
+
+QStringList MimeInfo::existingFiles(const QString &directory) noexcept
+{
+    const QDir dir{directory};
+    QStringList candidates{dir.filePath(fromStaticRaw(MimeinfoCache))};
+    const auto &desktops = getCurrentDesktops();
+    for (const auto &desktop : desktops) {
+        candidates.append(dir.filePath(desktop % fromStaticRaw(MimeappsDesktopSuffix)));
+    }
+    candidates.append(dir.filePath(fromStaticRaw(MimeappsList)));
+
+    QStringList ret;
+    for (auto &candidate : candidates) {
+        if (QFileInfo{candidate}.isFile()) {
+            ret.append(std::move(candidate));
+        }
+    }
+
     return ret;
 }
 
+bool MimeInfo::isLayoutChanged() const noexcept
+{
+    return existingFiles(m_directory) != m_existingFiles;
+}
+
 void MimeInfo::reload() noexcept
 {
     for (auto &app : m_appsList) {
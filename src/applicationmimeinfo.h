@@ -7,8 +7,10 @@
 
 #include <QStringList>
 #include <QFile>
+#include <memory>
 #include <optional>
 #include <QFileInfo>
+#include "mimecacheindex.h"
 #include "mimefileparser.h"
 #include <QLoggingCategory>
 
@@ -31,15 +33,34 @@ public:
     [[nodiscard]] const MimeContent &content() const noexcept { return m_content; }
     [[nodiscard]] bool isDesktopSpecific() const noexcept { return m_desktopSpec; }
     [[nodiscard]] bool isWritable() const noexcept { return m_writable; }
+    // compares mtime and size on disk with the ones recorded when the file was loaded
+    [[nodiscard]] bool isModified() const noexcept;
+    // call after the content has been written to the file
+    void updateStamp() noexcept;
 
     void reload() noexcept;
 
+protected:
+    struct FileStamp
+    {
+        qint64 mtime{-1};  // nsecs, -1 if the file doesn't exist
+        qint64 size{-1};
+        friend bool operator==(const FileStamp &lhs, const FileStamp &rhs) noexcept
+        {
+            return lhs.mtime == rhs.mtime && lhs.size == rhs.size;
+        }
+        friend bool operator!=(const FileStamp &lhs, const FileStamp &rhs) noexcept { return !(lhs == rhs); }
+    };
+
+    MimeFileBase(const QFileInfo &info, MimeContent &&content, bool desktopSpec, bool writable, FileStamp stamp);
+    [[nodiscard]] static FileStamp stampOf(const QString &filePath) noexcept;
+
 private:
-    MimeFileBase(const QFileInfo &info, MimeContent &&content, bool desktopSpec, bool writable);
     bool m_desktopSpec{false};
     bool m_writable{false};
     QFileInfo m_info;
     MimeContent m_content;
+    FileStamp m_stamp;
 };
 
 struct AppList
@@ -85,10 +106,16 @@ public:
     ~MimeCache() override = default;
 
     [[nodiscard]] QStringList queryApps(const QString &type) const noexcept;
-    [[nodiscard]] QStringList queryTypes(QString appId) const noexcept;
+    [[nodiscard]] QStringList queryTypes(const QString &appId) const noexcept;
+    [[nodiscard]] const std::shared_ptr<const MimeCacheIndex> &index() const noexcept { return m_index; }
+
+    void reload() noexcept;
 
 private:
-    explicit MimeCache(MimeFileBase &&base);
+    MimeCache(const QFileInfo &info, FileStamp stamp, std::shared_ptr<const MimeCacheIndex> index);
+
+    // content() is left empty, the cache is only queried through the mapped index
+    std::shared_ptr<const MimeCacheIndex> m_index;
 };
 
 class MimeInfo
@@ -107,11 +134,16 @@ public:
     [[nodiscard]] std::optional<MimeCache> &cacheInfo() noexcept { return m_cache; }
     [[nodiscard]] const std::optional<MimeCache> &cacheInfo() const noexcept { return m_cache; }
     [[nodiscard]] const QString &directory() const noexcept { return m_directory; }
+    // true if a mimeapps.list or mimeinfo.cache of this directory is created or removed since it's loaded
+    [[nodiscard]] bool isLayoutChanged() const noexcept;
 
     void reload() noexcept;
 
 private:
     MimeInfo() = default;
+    [[nodiscard]] static QStringList existingFiles(const QString &directory) noexcept;
+
+    QStringList m_existingFiles;
     std::vector<MimeApps> m_appsList;
     std::optional<MimeCache> m_cache{std::nullopt};
     QString m_directory;
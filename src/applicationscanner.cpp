@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationscanner.h"
+#include <QThread>
+#include <optional>
+
+namespace {
+void diffApplication(ApplicationDelta &delta,
+                     const ApplicationSnapshot &snapshot,
+                     DesktopFile file,
+                     QThread *target) noexcept
+{
+    const auto loaded = snapshot.constFind(file.desktopId());
+    if (loaded != snapshot.cend() && loaded->sourcePath == file.sourcePath() && !file.modified(loaded->mtime) &&
+        loaded->ctime == file.createTime()) {
+        return;
+    }
+
+    auto entry = std::make_unique<DesktopEntry>();
+    if (auto err = entry->parse(file); err != ParserError::NoError) {
+        qWarning() << "parse" << file.sourcePath() << "failed:" << err << ", skip it.";
+        return;
+    }
+
+    // the QFile was created here, hand it over before the worker thread goes back to the pool
+    if (target != nullptr) {
+        file.sourceFile()->moveToThread(target);
+    }
+
+    if (loaded == snapshot.cend()) {
+        delta.added.push_back({std::move(file), std::move(entry)});
+    } else if (loaded->entry != *entry) {
+        delta.changed.push_back({std::move(file), std::move(entry)});
+    } else {
+        delta.touched.push_back(std::move(file));
+    }
+}
+}  // namespace
+
+std::shared_ptr<ApplicationDelta>
+scanApplicationChanges(const ApplicationSnapshot &snapshot, const QStringList &dirs, QThread *target) noexcept
+{
+    auto delta = std::make_shared<ApplicationDelta>();
+    QSet<QString> seen;
+    seen.reserve(snapshot.size());
+
+    forEachApplicationDesktopFile(dirs, [&](DesktopFile file) -> bool {
+        if (snapshot.contains(file.desktopId())) {
+            seen.insert(file.desktopId());
+        }
+
+        diffApplication(*delta, snapshot, std::move(file), target);
+        return false;
+    });
+
+    for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+        if (!seen.contains(it.key())) {
+            delta->removed.append(it.key());
+        }
+    }
+
+    return delta;
+}
+
+std::shared_ptr<ApplicationDelta> scanApplicationFiles(const ApplicationSnapshot &snapshot,
+                                                       const QStringList &relativePaths,
+                                                       const QStringList &dirs,
+                                                       QThread *target) noexcept
+{
+    auto delta = std::make_shared<ApplicationDelta>();
+    QSet<QString> seen;
+
+    for (const auto &relativePath : relativePaths) {
+        auto id = desktopIdFromRelativePath(relativePath);
+        if (id.isEmpty() || seen.contains(id)) {
+            continue;
+        }
+        seen.insert(id);
+
+        // the same id may live under another relative path in a directory of higher priority
+        const QStringList candidates{relativePath, id + desktopSuffix.toString()};
+        std::optional<DesktopFile> found;
+        for (const auto &dirPath : dirs) {
+            const QDir dir{dirPath};
+            for (const auto &candidate : candidates) {
+                const QFileInfo info{dir.filePath(candidate)};
+                if (!info.isFile() || desktopIdFromRelativePath(dir.relativeFilePath(info.absoluteFilePath())) != id) {
+                    continue;
+                }
+
+                if (auto ret = DesktopFile::createDesktopFile(info, id); ret) {
+                    found.emplace(std::move(ret).value());
+                    break;
+                }
+            }
+
+            if (found) {
+                break;
+            }
+        }
+
+        if (found) {
+            diffApplication(*delta, snapshot, std::move(found).value(), target);
+        } else if (snapshot.contains(id)) {
+            delta->removed.append(id);
+        }
+    }
+
+    return delta;
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONSCANNER_H
+#define APPLICATIONSCANNER_H
+
+#include "desktopentry.h"
+#include "global.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class QThread;
+
+inline QString desktopIdFromRelativePath(QStringView relativePath) noexcept
+{
+    if (!relativePath.endsWith(desktopSuffix)) {
+        return {};
+    }
+
+    auto id = relativePath.chopped(desktopSuffix.size()).toString();
+    id.replace(QDir::separator(), u'-');
+    return id;
+}
+
+// stops iterating once func returns true, a desktop id found in an earlier directory shadows the later ones.
+template <typename T>
+void forEachApplicationDesktopFile(const QStringList &dirs, T &&func) noexcept
+{
+    static_assert(std::is_invocable_v<T, DesktopFile>,
+                  "application desktop iterator callback should accept one DesktopFile argument");
+
+    QSet<QString> seenDesktopIds;
+    for (const auto &dirPath : dirs) {
+        const QFileInfo dirInfo{dirPath};
+        if (!dirInfo.isDir()) {
+            continue;
+        }
+
+        QDirIterator it{dirPath,
+                        {QStringLiteral("*.desktop")},
+                        QDir::Files | QDir::NoDotAndDotDot | QDir::Readable,
+                        QDirIterator::Subdirectories};
+        while (it.hasNext()) {
+            const auto info = it.nextFileInfo();
+            const auto relativePath = QDir{dirPath}.relativeFilePath(info.absoluteFilePath());
+            auto ret = DesktopFile::createDesktopFile(info, desktopIdFromRelativePath(relativePath));
+            if (!ret) {
+                continue;
+            }
+
+            auto file = std::move(ret).value();
+            if (file.desktopId().isEmpty() || seenDesktopIds.contains(file.desktopId())) {
+                continue;
+            }
+
+            seenDesktopIds.insert(file.desktopId());
+            if (func(std::move(file))) {
+                return;
+            }
+        }
+    }
+}
+
+// What a reload needs to know about a loaded application, it's copied on the main thread and read by the worker.
+struct ApplicationSnapshotEntry
+{
+    QString sourcePath;
+    qint64 mtime{0};
+    qint64 ctime{0};
+    DesktopEntry entry;
+};
+
+using ApplicationSnapshot = QHash<QString, ApplicationSnapshotEntry>;
+
+struct ApplicationDelta
+{
+    struct Entry
+    {
+        DesktopFile file;
+        std::unique_ptr<DesktopEntry> entry;
+    };
+
+    std::vector<Entry> added;          // not loaded yet, they still need to pass the filters
+    std::vector<Entry> changed;        // the entry differs from the loaded one
+    std::vector<DesktopFile> touched;  // the source file is replaced but the entry is the same
+    QStringList removed;
+
+    [[nodiscard]] bool isEmpty() const noexcept
+    {
+        return added.empty() && changed.empty() && touched.empty() && removed.isEmpty();
+    }
+};
+
+// Scans dirs and diffs them against snapshot, only desktop files whose mtime, ctime or path changed are parsed.
+// It's meant to run on a worker thread, the returned desktop files are moved to target.
+[[nodiscard]] std::shared_ptr<ApplicationDelta>
+scanApplicationChanges(const ApplicationSnapshot &snapshot, const QStringList &dirs, QThread *target) noexcept;
+
+// Like scanApplicationChanges, but only the desktop ids of relativePaths are looked up in dirs.
+// snapshot should only hold those ids, the ones not found in any dir are reported as removed.
+[[nodiscard]] std::shared_ptr<ApplicationDelta> scanApplicationFiles(const ApplicationSnapshot &snapshot,
+                                                                     const QStringList &relativePaths,
+                                                                     const QStringList &dirs,
+                                                                     QThread *target) noexcept;
+
+#endif
@@ -0,0 +1,338 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationsearchindex.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+// Han text isn't separated by spaces, index all suffixes so that a prefix lookup matches any substring.
+constexpr qsizetype MaxHanSuffixes = 16;
+constexpr double MinTrigramRatio = 0.5;
+constexpr qint64 MsecsPerDay = 24 * 60 * 60 * 1000;
+
+bool isHan(QChar ch) noexcept
+{
+    return ch.script() == QChar::Script_Han;
+}
+}  // namespace
+
+void ApplicationSearchIndex::addTransliterator(Transliterator transliterator) noexcept
+{
+    if (transliterator) {
+        m_transliterators.append(std::move(transliterator));
+    }
+}
+
+QString ApplicationSearchIndex::normalize(const QString &text) noexcept
+{
+    const auto decomposed = text.normalized(QString::NormalizationForm_KD);
+    QString ret;
+    ret.reserve(decomposed.size());
+    for (const auto ch : decomposed) {
+        if (ch.category() == QChar::Mark_NonSpacing) {
+            continue;
+        }
+        ret.append(ch);
+    }
+
+    return ret.toCaseFolded();
+}
+
+QStringList ApplicationSearchIndex::tokenize(const QString &normalizedText) noexcept
+{
+    QStringList tokens;
+    QString current;
+    for (const auto ch : normalizedText) {
+        if (ch.isLetterOrNumber()) {
+            current.append(ch);
+            continue;
+        }
+
+        if (!current.isEmpty()) {
+            tokens.append(std::move(current));
+            current.clear();
+        }
+    }
+
+    if (!current.isEmpty()) {
+        tokens.append(std::move(current));
+    }
+
+    return tokens;
+}
+
+QSet<QString> ApplicationSearchIndex::trigramsOf(const QString &token) noexcept
+{
+    QSet<QString> ret;
+    for (qsizetype i = 0; i + 3 <= token.size(); ++i) {
+        ret.insert(token.mid(i, 3));
+    }
+    return ret;
+}
+
+void ApplicationSearchIndex::addField(IndexedDocument &document, const QStringList &values, int weight) const noexcept
+{
+    auto addToken = [&document, weight](const QString &token) {
+        auto &best = document.tokens[token];
+        best = std::max(best, weight);
+    };
+
+    for (const auto &value : values) {
+        const auto normalized = normalize(value);
+        QStringList forms{normalized};
+        for (const auto &transliterator : m_transliterators) {
+            forms.append(transliterator(normalized));
+        }
+
+        for (const auto &form : std::as_const(forms)) {
+            const auto tokens = tokenize(form);
+            for (const auto &token : tokens) {
+                addToken(token);
+                if (!isHan(token.front())) {
+                    continue;
+                }
+
+                for (qsizetype i = 1; i < std::min(token.size(), MaxHanSuffixes); ++i) {
+                    addToken(token.sliced(i));
+                }
+            }
+        }
+    }
+}
+
+void ApplicationSearchIndex::insertToken(const QString &appId, const QString &token) noexcept
+{
+    auto *node = &m_root;
+    for (const auto ch : token) {
+        auto &child = node->children[ch];
+        if (!child) {
+            child = std::make_unique<TrieNode>();
+        }
+        node = child.get();
+        ++node->apps[appId];
+    }
+}
+
+void ApplicationSearchIndex::removeToken(const QString &appId, const QString &token) noexcept
+{
+    std::vector<std::pair<TrieNode *, QChar>> path;
+    path.reserve(token.size());
+
+    auto *node = &m_root;
+    for (const auto ch : token) {
+        auto it = node->children.find(ch);
+        if (it == node->children.end()) {
+            return;
+        }
+        path.emplace_back(node, ch);
+        node = it->second.get();
+        if (auto count = node->apps.find(appId); count != node->apps.end() && --count.value() == 0) {
+            node->apps.erase(count);
+        }
+    }
+
+    // prune branches nobody passes anymore
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        auto &[parent, ch] = *it;
+        auto child = parent->children.find(ch);
+        if (!child->second->apps.isEmpty() || !child->second->children.empty()) {
+            break;
+        }
+        parent->children.erase(child);
+    }
+}
+
+const ApplicationSearchIndex::TrieNode *ApplicationSearchIndex::findPrefix(const QString &prefix) const noexcept
+{
+    const auto *node = &m_root;
+    for (const auto ch : prefix) {
+        auto it = node->children.find(ch);
+        if (it == node->children.end()) {
+            return nullptr;
+        }
+        node = it->second.get();
+    }
+    return node;
+}
+
+void ApplicationSearchIndex::update(const QString &appId, const SearchDocument &document) noexcept
+{
+    remove(appId);
+
+    IndexedDocument indexed;
+    addField(indexed, document.names, NameWeight);
+    addField(indexed, document.genericNames, GenericNameWeight);
+    addField(indexed, document.keywords, KeywordWeight);
+    addField(indexed, document.comments, CommentWeight);
+
+    for (auto it = indexed.tokens.cbegin(); it != indexed.tokens.cend(); ++it) {
+        insertToken(appId, it.key());
+        indexed.trigrams.unite(trigramsOf(it.key()));
+    }
+
+    for (const auto &trigram : std::as_const(indexed.trigrams)) {
+        m_trigramPostings[trigram].insert(appId);
+    }
+
+    m_documents.insert(appId, std::move(indexed));
+}
+
+void ApplicationSearchIndex::remove(const QString &appId) noexcept
+{
+    auto doc = m_documents.find(appId);
+    if (doc == m_documents.end()) {
+        return;
+    }
+
+    for (auto it = doc->tokens.cbegin(); it != doc->tokens.cend(); ++it) {
+        removeToken(appId, it.key());
+    }
+
+    for (const auto &trigram : std::as_const(doc->trigrams)) {
+        auto posting = m_trigramPostings.find(trigram);
+        if (posting == m_trigramPostings.end()) {
+            continue;
+        }
+
+        posting->remove(appId);
+        if (posting->isEmpty()) {
+            m_trigramPostings.erase(posting);
+        }
+    }
+
+    m_documents.erase(doc);
+}
+
+void ApplicationSearchIndex::clear() noexcept
+{
+    m_root.children.clear();
+    m_root.apps.clear();
+    m_documents.clear();
+    m_trigramPostings.clear();
+}
+
+double ApplicationSearchIndex::frecencyBoost(const SearchFrecency &frecency, qint64 now) noexcept
+{
+    if (frecency.launchedTimes <= 0) {
+        return 0;
+    }
+
+    const auto ageDays = static_cast<double>(now - frecency.lastLaunchedTime) / MsecsPerDay;
+    double recency{0.3};
+    if (ageDays < 1) {
+        recency = 1.0;
+    } else if (ageDays < 7) {
+        recency = 0.7;
+    } else if (ageDays < 30) {
+        recency = 0.5;
+    }
+
+    return 0.25 * std::log2(1.0 + static_cast<double>(frecency.launchedTimes)) * recency;
+}
+
+QStringList ApplicationSearchIndex::search(const QString &query,
+                                           qsizetype limit,
+                                           const FrecencyProvider &frecency,
+                                           qint64 now) const noexcept
+{
+    const auto queryTokens = tokenize(normalize(query));
+    if (queryTokens.isEmpty()) {
+        return {};
+    }
+
+    // every token of query should match, scores of tokens are summed up
+    QHash<QString, double> scores;
+    bool firstToken{true};
+    for (const auto &queryToken : queryTokens) {
+        QHash<QString, double> tokenScores;
+
+        if (const auto *node = findPrefix(queryToken); node != nullptr) {
+            for (auto it = node->apps.cbegin(); it != node->apps.cend(); ++it) {
+                const auto doc = m_documents.constFind(it.key());
+                if (doc == m_documents.cend()) {
+                    continue;
+                }
+
+                double best{0};
+                for (auto token = doc->tokens.cbegin(); token != doc->tokens.cend(); ++token) {
+                    if (token.key() == queryToken) {
+                        best = std::max(best, token.value() * 3.0);
+                    } else if (token.key().startsWith(queryToken)) {
+                        best = std::max(best, token.value() * 2.0);
+                    }
+                }
+                tokenScores.insert(it.key(), best);
+            }
+        }
+
+        if (const auto queryTrigrams = trigramsOf(queryToken); !queryTrigrams.isEmpty()) {
+            QHash<QString, int> hits;
+            for (const auto &trigram : queryTrigrams) {
+                if (auto posting = m_trigramPostings.constFind(trigram); posting != m_trigramPostings.cend()) {
+                    for (const auto &appId : *posting) {
+                        ++hits[appId];
+                    }
+                }
+            }
+
+            for (auto it = hits.cbegin(); it != hits.cend(); ++it) {
+                const auto ratio = static_cast<double>(it.value()) / static_cast<double>(queryTrigrams.size());
+                if (ratio < MinTrigramRatio) {
+                    continue;
+                }
+
+                auto &score = tokenScores[it.key()];
+                score = std::max(score, ratio);
+            }
+        }
+
+        if (firstToken) {
+            scores = std::move(tokenScores);
+            firstToken = false;
+            continue;
+        }
+
+        for (auto it = scores.begin(); it != scores.end();) {
+            if (auto matched = tokenScores.constFind(it.key()); matched != tokenScores.cend()) {
+                it.value() += matched.value();
+                ++it;
+            } else {
+                it = scores.erase(it);
+            }
+        }
+    }
+
+    if (now == 0) {
+        now = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    std::vector<std::pair<double, QString>> ranked;
+    ranked.reserve(scores.size());
+    for (auto it = scores.cbegin(); it != scores.cend(); ++it) {
+        auto score = it.value();
+        if (frecency) {
+            score *= 1.0 + frecencyBoost(frecency(it.key()), now);
+        }
+        ranked.emplace_back(score, it.key());
+    }
+
+    std::sort(ranked.begin(), ranked.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+
+    if (limit > 0 && static_cast<qsizetype>(ranked.size()) > limit) {
+        ranked.resize(static_cast<size_t>(limit));
+    }
+
+    QStringList ret;
+    ret.reserve(static_cast<qsizetype>(ranked.size()));
+    for (auto &[score, appId] : ranked) {
+        ret.append(std::move(appId));
+    }
+
+    return ret;
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONSEARCHINDEX_H
+#define APPLICATIONSEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <map>
+#include <memory>
+
+struct SearchDocument
+{
+    QStringList names;
+    QStringList genericNames;
+    QStringList keywords;
+    QStringList comments;
+};
+
+struct SearchFrecency
+{
+    qint64 launchedTimes{0};
+    qint64 lastLaunchedTime{0};  // msecs since epoch
+};
+
+// Incremental full text index over the localized strings of applications.
+// Tokens are kept in a prefix trie for "as you type" matching and in trigram postings for typo tolerant matching.
+class ApplicationSearchIndex
+{
+public:
+    // Produces alternative spellings of a normalized string, e.g. pinyin of Chinese characters.
+    using Transliterator = std::function<QStringList(const QString &)>;
+    using FrecencyProvider = std::function<SearchFrecency(const QString &)>;
+
+    ApplicationSearchIndex() = default;
+    ~ApplicationSearchIndex() = default;
+    ApplicationSearchIndex(const ApplicationSearchIndex &) = delete;
+    ApplicationSearchIndex(ApplicationSearchIndex &&) = delete;
+    ApplicationSearchIndex &operator=(const ApplicationSearchIndex &) = delete;
+    ApplicationSearchIndex &operator=(ApplicationSearchIndex &&) = delete;
+
+    // transliterators only apply to documents updated after they're added.
+    void addTransliterator(Transliterator transliterator) noexcept;
+
+    void update(const QString &appId, const SearchDocument &document) noexcept;
+    void remove(const QString &appId) noexcept;
+    void clear() noexcept;
+    [[nodiscard]] qsizetype size() const noexcept { return m_documents.size(); }
+
+    // limit <= 0 means no limit
+    [[nodiscard]] QStringList search(const QString &query,
+                                     qsizetype limit,
+                                     const FrecencyProvider &frecency = {},
+                                     qint64 now = 0) const noexcept;
+
+    [[nodiscard]] static QString normalize(const QString &text) noexcept;
+    [[nodiscard]] static QStringList tokenize(const QString &normalizedText) noexcept;
+
+private:
+    enum FieldWeight : int { CommentWeight = 1, KeywordWeight = 2, GenericNameWeight = 3, NameWeight = 4 };
+
+    struct TrieNode
+    {
+        std::map<QChar, std::unique_ptr<TrieNode>> children;
+        QHash<QString, int> apps;  // appId -> number of its tokens passing this node
+    };
+
+    struct IndexedDocument
+    {
+        QHash<QString, int> tokens;  // token -> best field weight
+        QSet<QString> trigrams;
+    };
+
+    TrieNode m_root;
+    QHash<QString, IndexedDocument> m_documents;
+    QHash<QString, QSet<QString>> m_trigramPostings;
+    QList<Transliterator> m_transliterators;
+
+    void addField(IndexedDocument &document, const QStringList &values, int weight) const noexcept;
+    void insertToken(const QString &appId, const QString &token) noexcept;
+    void removeToken(const QString &appId, const QString &token) noexcept;
+    [[nodiscard]] const TrieNode *findPrefix(const QString &prefix) const noexcept;
+    [[nodiscard]] static QSet<QString> trigramsOf(const QString &token) noexcept;
+    [[nodiscard]] static double frecencyBoost(const SearchFrecency &frecency, qint64 now) noexcept;
+};
+
+#endif
@@ -7,6 +7,72 @@
 #include <QFile>
 #include <QString>
 #include <QDebug>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::optional<quint64> CGroupsIdentifier::cgroupIdOf(pid_t pid) noexcept
+{
+    char path[PATH_MAX]{};
+    std::snprintf(path, sizeof(path), "/proc/%d/cgroup", pid);
+    auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return std::nullopt;
+    }
+
+    char content[PATH_MAX]{};
+    auto len = ::read(fd, content, sizeof(content) - 1);
+    ::close(fd);
+    if (len <= 0) {
+        return std::nullopt;
+    }
+
+    // the cgroup v2 entry looks like "0::/user.slice/..."
+    const char *line = content;
+    const char *end = content + len;
+    while (line < end && std::strncmp(line, "0::", 3) != 0) {
+        const auto *next = static_cast<const char *>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        line = next + 1;
+    }
+
+    if (line >= end) {
+        return std::nullopt;
+    }
+
+    const char *cgroup = line + 3;
+    const auto *lineEnd = static_cast<const char *>(std::memchr(cgroup, '\n', static_cast<size_t>(end - cgroup)));
+    const auto cgroupLen = static_cast<int>((lineEnd != nullptr ? lineEnd : end) - cgroup);
+    // processes in the root cgroup, or on hybrid hierarchy whose /sys/fs/cgroup isn't cgroup2
+    if (cgroupLen <= 1) {
+        return std::nullopt;
+    }
+
+    if (std::snprintf(path, sizeof(path), "/sys/fs/cgroup%.*s", cgroupLen, cgroup) >= static_cast<int>(sizeof(path))) {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (::stat(path, &st) == -1) {
+        return std::nullopt;
+    }
+
+    return static_cast<quint64>(st.st_ino);
+}
+
+void CGroupsIdentifier::unitRemoved(const QString &unitName) noexcept
+{
+    QMutexLocker locker{&m_cacheMutex};
+    const auto cgroupIds = m_unitCGroups.take(unitName);
+    for (const auto cgroupId : cgroupIds) {
+        m_cache.remove(cgroupId);
+    }
+}
 
 IdentifyRet CGroupsIdentifier::Identify(const QDBusUnixFileDescriptor &pidfd)
 {
@@ -17,6 +83,25 @@ IdentifyRet CGroupsIdentifier::Identify(const QDBusUnixFileDescriptor &pidfd)
         return {};
     }
 
+    const auto cgroupId = cgroupIdOf(static_cast<pid_t>(pid));
+    if (cgroupId) {
+        std::optional<IdentifyRet> cachedRet;
+        {
+            QMutexLocker locker{&m_cacheMutex};
+            if (auto cached = m_cache.constFind(*cgroupId); cached != m_cache.cend()) {
+                cachedRet = cached->ret;
+            }
+        }
+
+        if (cachedRet) {
+            if (pidfd_send_signal(pidfd.fileDescriptor(), 0, nullptr, 0) != 0) {
+                qWarning() << "pidfd is no longer valid (process may have exited)";
+                return {};
+            }
+            return std::move(cachedRet).value();
+        }
+    }
+
     using namespace Qt::StringLiterals;
     // Perform identification using PID
     auto AppCgroupPath = u"/proc/" % QString::number(pid) % u"/cgroup";
@@ -50,7 +135,14 @@ IdentifyRet CGroupsIdentifier::Identify(const QDBusUnixFileDescriptor &pidfd)
         return {};
     }
 
-    return {std::move(appId), std::move(InstanceId)};
+    IdentifyRet ret{std::move(appId), std::move(InstanceId), IdentifyConfidence::High};
+    if (cgroupId) {
+        QMutexLocker locker{&m_cacheMutex};
+        m_cache.insert(*cgroupId, CacheEntry{ret, UnitStr});
+        m_unitCGroups[UnitStr].insert(*cgroupId);
+    }
+
+    return ret;
 }
 
 QString CGroupsIdentifier::parseCGroupsPath(QFile &cgroupFile) noexcept
@@ -7,13 +7,34 @@
 
 #include "identifier.h"
 #include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <optional>
+#include <sys/types.h>
 
+// Identify is safe to be called from several threads at the same time.
 class CGroupsIdentifier : public Identifier
 {
 public:
     IdentifyRet Identify(const QDBusUnixFileDescriptor &pidfd) override;
+    void unitRemoved(const QString &unitName) noexcept override;
+
+    // inode of the cgroup v2 directory of process, a removed cgroup never shares it with a new one
+    [[nodiscard]] static std::optional<quint64> cgroupIdOf(pid_t pid) noexcept;
 
 private:
+    struct CacheEntry
+    {
+        IdentifyRet ret;
+        QString unitName;
+    };
+
+    QMutex m_cacheMutex;
+    QHash<quint64, CacheEntry> m_cache;
+    // a unit may own several cgroups, e.g. sub-cgroups created by the app itself
+    QHash<QString, QSet<quint64>> m_unitCGroups;
+
     [[nodiscard]] static QString parseCGroupsPath(QFile &file) noexcept;
 };
 
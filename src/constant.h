@@ -10,6 +10,9 @@
 
 constexpr static auto &SystemdPropInterfaceName = u"org.freedesktop.DBus.Properties";
 constexpr static auto &SystemdUnitInterfaceName = u"org.freedesktop.systemd1.Unit";
+constexpr static auto &SystemdServiceInterfaceName = u"org.freedesktop.systemd1.Service";
+constexpr static auto &SystemdScopeInterfaceName = u"org.freedesktop.systemd1.Scope";
+constexpr static auto &SystemdUnitPathNamespace = u"/org/freedesktop/systemd1/unit/";
 constexpr static auto &DDEApplicationManager1ServiceName =
 #ifdef DDE_AM_USE_DEBUG_DBUS_NAME
     u"org.desktopspec.debug.ApplicationManager1";
@@ -59,6 +62,7 @@ constexpr static auto &LaunchedTimes = u"LaunchedTimes";
 constexpr static auto &InstalledTime = u"InstalledTime";
 
 constexpr static auto &ApplicationManagerHookDir = u"/deepin/dde-application-manager/hooks.d";
+constexpr static auto &MimeCacheIndexDir = u"/deepin/dde-application-manager/mime";
 
 constexpr static auto &ApplicationManagerToolsConfig = u"org.deepin.dde.am";
 
@@ -68,6 +72,8 @@ constexpr static auto &AppExtraEnvironments = u"appExtraEnvironments";
 constexpr static auto &AppEnvironmentsBlacklist = u"appEnvironmentsBlacklist";
 constexpr static auto &SkipEventAppIds = u"skipEventAppIds";
 
+constexpr static auto &PackageTransactionMarker = u"/run/dde-application-manager/dpkg-transaction";
+
 constexpr static auto &CompatibilityConfigFilePath = u"/var/lib/compatible/compatibleDesktop.json";
 
 constexpr auto desktopSuffix = QStringView{u".desktop"};
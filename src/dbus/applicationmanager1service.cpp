@@ -1,29 +1,39 @@
 // SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
 //
 // SPDX-License-Identifier: LGPL-3.0-or-later
-#include "applicationadaptor.h"
 #include "applicationHooks.h"
 #include "applicationchecker.h"
+#include "applicationindexwriter.h"
+#include "applicationscanner.h"
 #include "applicationservice.h"
 #include "dbus/instanceservice.h"
 #include "dbus/AMobjectmanager1adaptor.h"
 #include "dbus/applicationmanager1adaptor.h"
+#include "dbus/applicationobjectdispatcher.h"
 #include "desktopfilegenerator.h"
 #include "eventreporter.h"
+#include "executableidentifier.h"
+#include "executableindex.h"
 #include "global.h"
+#include "packageindex.h"
 #include "propertiesForwarder.h"
 #include "systemdsignaldispatcher.h"
 #include <DUtil>
 #include <QDBusMessage>
 #include <QDBusVariant>
+#include <QDateTime>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QGuiApplication>
 #include <QHash>
+#include <QIcon>
 #include <QLoggingCategory>
 #include <QProcess>
 #include <QSet>
 #include <QStringBuilder>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 #include <unistd.h>
 
 using namespace Qt::StringLiterals;
@@ -31,6 +41,11 @@ using namespace Qt::StringLiterals;
 Q_LOGGING_CATEGORY(DDEAM, "dde.am.manager")
 
 namespace {
+// longer lists of changed desktop files are cheaper to handle by a full reload
+constexpr qsizetype MaxTargetedReloadFiles = 64;
+// reading /proc is cheap enough that a few threads saturate it
+constexpr int IdentifyThreadCount = 4;
+
 template <typename Adaptor>
 void setAdaptorAutoRelaySignals(Adaptor *adaptor, bool enabled) noexcept
 {
@@ -58,53 +73,6 @@ struct ParsedAutostartEntry
     DesktopEntry entry;
 };
 
-QString desktopIdFromRelativePath(QStringView relativePath) noexcept
-{
-    if (!relativePath.endsWith(desktopSuffix)) {
-        return {};
-    }
-
-    auto id = relativePath.chopped(desktopSuffix.size()).toString();
-    id.replace(QDir::separator(), u'-');
-    return id;
-}
-
-template <typename T>
-void forEachApplicationDesktopFile(T &&func) noexcept
-{
-    static_assert(std::is_invocable_v<T, DesktopFile>,
-                  "application desktop iterator callback should accept one DesktopFile argument");
-
-    QSet<QString> seenDesktopIds;
-    for (const auto &dirPath : getApplicationsDirs()) {
-        const QFileInfo dirInfo{dirPath};
-        if (!dirInfo.isDir()) {
-            continue;
-        }
-
-        QDirIterator it{
-            dirPath, {u"*.desktop"_s}, QDir::Files | QDir::NoDotAndDotDot | QDir::Readable, QDirIterator::Subdirectories};
-        while (it.hasNext()) {
-            const auto info = it.nextFileInfo();
-            const auto relativePath = QDir{dirPath}.relativeFilePath(info.absoluteFilePath());
-            auto ret = DesktopFile::createDesktopFile(info, desktopIdFromRelativePath(relativePath));
-            if (!ret) {
-                continue;
-            }
-
-            auto file = std::move(ret).value();
-            if (file.desktopId().isEmpty() || seenDesktopIds.contains(file.desktopId())) {
-                continue;
-            }
-
-            seenDesktopIds.insert(file.desktopId());
-            if (func(std::move(file))) {
-                return;
-            }
-        }
-    }
-}
-
 template <typename T>
 void forEachAutostartDesktopFile(T &&func) noexcept
 {
@@ -160,6 +128,12 @@ void forEachAutostartDesktopFile(T &&func) noexcept
     guard.close();
     return ParsedAutostartEntry{std::move(desktopFile), std::move(entry)};
 }
+
+// created by the dpkg pre-invoke hook and removed by the post-invoke hook, see misc/dpkg
+bool isPackageTransactionRunning() noexcept
+{
+    return QFileInfo::exists(fromStaticRaw(PackageTransactionMarker));
+}
 }  // namespace
 
 ApplicationManager1Service::~ApplicationManager1Service() = default;
@@ -167,8 +141,12 @@ ApplicationManager1Service::~ApplicationManager1Service() = default;
 ApplicationManager1Service::ApplicationManager1Service(std::unique_ptr<Identifier> ptr,
                                                        std::weak_ptr<ApplicationManager1Storage> storage) noexcept
     : m_identifier(std::move(ptr))
+    , m_executableIdentifier(std::make_unique<ExecutableIdentifier>(m_lookupIndex))
     , m_storage(std::move(storage))
+    , m_iconResolver(QIcon::themeName())
 {
+    m_identifyPool.setMaxThreadCount(IdentifyThreadCount);
+
     // Initialize prelaunch splash helper only when running on Wayland.
     bool isWayland = false;
     if (auto *app = qobject_cast<QGuiApplication *>(QCoreApplication::instance())) {
@@ -188,9 +166,19 @@ ApplicationManager1Service::ApplicationManager1Service(std::unique_ptr<Identifie
         qCInfo(amPrelaunchSplash) << "Skip PrelaunchSplashHelper (not running on Wayland)";
     }
 
-    m_reloadTimer.setInterval(500);
+    if (m_splashHelper) {
+        connect(&m_iconResolver, &IconThemeResolver::iconFilesChanged, this, [this]() {
+            m_splashHelper->invalidateIconCache();
+        });
+    }
+
+    m_reloadClock.start();
     m_reloadTimer.setSingleShot(true);
-    connect(&m_reloadTimer, &QTimer::timeout, this, &ApplicationManager1Service::doReloadApplications);
+    connect(&m_reloadTimer, &QTimer::timeout, this, &ApplicationManager1Service::onReloadTimeout);
+
+    m_indexTimer.setInterval(200);
+    m_indexTimer.setSingleShot(true);
+    connect(&m_indexTimer, &QTimer::timeout, this, &ApplicationManager1Service::publishApplicationIndex);
 }
 
 void ApplicationManager1Service::initService(QDBusConnection &connection) noexcept
@@ -224,6 +212,11 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
         std::terminate();
     }
 
+    if (m_objectDispatcher.reset(new (std::nothrow) ApplicationObjectDispatcher{this}); !m_objectDispatcher) {
+        qCCritical(DDEAM) << "new ApplicationObjectDispatcher failed.";
+        std::terminate();
+    }
+
     if (m_compatibilityManager.reset(new (std::nothrow) CompatibilityManager()); !m_compatibilityManager) {
         qWarning() << "new CompatibilityManager failed.";
     }
@@ -233,17 +226,24 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
         qCInfo(DDEAM) << "Session override config changed, rebuilding application list.";
         doReloadApplications();
     });
+    connect(m_sessionOverrideConfig.get(),
+            &SessionOverrideConfig::overridesChanged,
+            this,
+            &ApplicationManager1Service::reevaluateApplications);
     connect(m_sessionOverrideConfig.get(), &SessionOverrideConfig::overrideChanged,
             this, [this](const QString &desktopId, const QString &key) {
         auto app = m_applicationList.value(desktopId);
         if (!app)
             return;
+        std::ignore = app->ensureMaterialized();
         if (key == u"Icon"_s) {
             qCInfo(DDEAM) << "Icon override changed for" << desktopId << ", emitting iconsChanged.";
             emit app->iconsChanged();
+            scheduleApplicationIndexUpdate();
         } else if (key == u"Exec"_s || key == u"TryExec"_s) {
             qCInfo(DDEAM) << "Exec/TryExec override changed for" << desktopId << ", emitting execsChanged.";
             emit app->execsChanged();
+            updateLookupIndex(*app);
         }
     });
 
@@ -298,6 +298,14 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
             this,
             &ApplicationManager1Service::onUnitRemoved);
 
+    connect(&dispatcher,
+            &SystemdSignalDispatcher::SystemdUnitResultChanged,
+            this,
+            [](const QDBusObjectPath &systemdUnitPath, const QString &result) {
+                qCDebug(DDEAM) << "unit result changed: unitPath=" << systemdUnitPath.path() << "result=" << result;
+                InstanceIndex::instance().setUnitResult(systemdUnitPath.path(), result);
+            });
+
     auto envToPath = [this](const QStringList &envs) {
         auto path = std::find_if(envs.cbegin(), envs.cend(), [](QStringView env) { return env.startsWith(u"PATH="); });
         if (path == envs.cend()) {
@@ -305,11 +313,22 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
         }
 
         auto pathView = QStringView{*path}.sliced(5);
-        auto tokens = qTokenize(pathView, u':', Qt::SkipEmptyParts);
-        m_systemdPathEnv.clear();
+        QStringList pathEnv;
+        for (auto view : qTokenize(pathView, u':', Qt::SkipEmptyParts)) {
+            pathEnv.append(view.toString());
+        }
+
+        // Environment changes with every set-environment call, most of which leave PATH alone
+        if (pathEnv == m_systemdPathEnv) {
+            return;
+        }
+
+        m_systemdPathEnv = std::move(pathEnv);
+        ExecutableIndex::instance().setSearchPaths(m_systemdPathEnv);
 
-        for (auto view : tokens) {
-            m_systemdPathEnv.append(view.toString());
+        // relative Exec programs may be resolved to other binaries now
+        for (const auto &app : std::as_const(m_applicationList)) {
+            updateLookupIndex(*app);
         }
     };
 
@@ -334,6 +353,15 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
                         SLOT(ReloadApplications()))) {
         qFatal("connect to ApplicationUpdated failed.");
     }
+    if (!sysBus.connect(u"org.desktopspec.ApplicationUpdateNotifier1"_s,
+                        u"/org/desktopspec/ApplicationUpdateNotifier1"_s,
+                        u"org.desktopspec.ApplicationUpdateNotifier1"_s,
+                        u"ApplicationFilesUpdated"_s,
+                        this,
+                        SLOT(onApplicationFilesUpdated(QStringList)))) {
+        qFatal("connect to ApplicationFilesUpdated failed.");
+    }
+    PackageIndex::instance().refresh();
 
     auto storagePtr = m_storage.lock();
     if (storagePtr) {
@@ -350,6 +378,8 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
 
     loadHooks();
 
+    prewarmSplashIcons();
+
     EventReporter::instance().initialize();
 
     if (storagePtr) {
@@ -368,10 +398,13 @@ void ApplicationManager1Service::initService(QDBusConnection &connection) noexce
 
     m_startupPhase = false;
 
+    publishApplicationIndex();
+
     qCInfo(DDEAM) << "Application Manager started.";
 
+    // the others get their forwarder once they're materialized
     for (const auto &application : std::as_const(m_applicationList)) {
-        if (!application->ensurePropertiesForwarder()) {
+        if (application->isMaterialized() && !application->ensurePropertiesForwarder()) {
             qCCritical(DDEAM) << "failed to initialize PropertiesForwarder for" << application->id();
         }
     }
@@ -429,16 +462,21 @@ void ApplicationManager1Service::onUnitNew(const QString &unitName,
 void ApplicationManager1Service::onUnitRemoved(const QString &unitName,
                                                const QDBusObjectPath &systemdUnitPath) noexcept
 {
-    auto info = processUnitName(unitName);
-    if (!info || info->applicationID.isEmpty()) {
+    m_identifier->unitRemoved(unitName);
+
+    auto &index = InstanceIndex::instance();
+    const auto *entry = index.findByUnitPath(systemdUnitPath.path());
+    if (entry == nullptr) {
         return;
     }
 
-    auto app = m_applicationList.value(info->applicationID);
+    QSharedPointer<ApplicationService> app;
+    if (!entry->orphaned) {
+        app = m_applicationList.value(entry->appId);
+    }
+
     if (!app) {
-        orphanedInstances.removeIf([&systemdUnitPath](const QSharedPointer<InstanceService> &ptr) {
-            return (ptr->property("SystemdUnitPath").value<QDBusObjectPath>() == systemdUnitPath);
-        });
+        index.remove(systemdUnitPath.path());
         return;
     }
 
@@ -454,18 +492,20 @@ void ApplicationManager1Service::scanMimeInfos() noexcept
             m_mimeManager->appendMimeInfo(std::move(info).value());
         }
     }
+
+    m_mimeManager->rebuildResolutionTable();
 }
 
 void ApplicationManager1Service::reloadMimeInfos() noexcept
 {
-    m_mimeManager->reset();
-    scanMimeInfos();
-    emit m_mimeManager->MimeInfoReloaded();
+    if (m_mimeManager->refreshMimeInfos(getMimeDirs())) {
+        emit m_mimeManager->MimeInfoReloaded();
+    }
 }
 
 void ApplicationManager1Service::scanApplications() noexcept
 {
-    forEachApplicationDesktopFile([this](DesktopFile file) -> bool {
+    forEachApplicationDesktopFile(getApplicationsDirs(), [this](DesktopFile file) -> bool {
         const auto desktopId = file.desktopId();
         if (!addApplication(std::move(file))) {
             qWarning() << "add Application" << desktopId << " failed, skip...";
@@ -597,6 +637,183 @@ void ApplicationManager1Service::loadHooks() noexcept
     m_hookElements = generateHooks(hookList);
 }
 
+void ApplicationManager1Service::scheduleApplicationIndexUpdate() noexcept
+{
+    if (m_startupPhase) {
+        return;
+    }
+
+    m_indexTimer.start();
+}
+
+void ApplicationManager1Service::publishApplicationIndex() noexcept
+{
+    QList<ApplicationIndexEntry> entries;
+    entries.reserve(m_applicationList.size());
+    for (const auto &app : std::as_const(m_applicationList)) {
+        ApplicationIndexEntry entry;
+        entry.id = app->id();
+        entry.objectPath = app->applicationPath().path();
+        entry.name =
+            app->findEntryValue(fromStaticRaw(DesktopFileEntryKey), fromStaticRaw(DesktopEntryName), EntryValueType::LocaleString)
+                .toString();
+        entry.icon = app->icons().value(fromStaticRaw(DesktopFileEntryKey));
+        entry.categories = app->categories();
+        entry.startupWMClass = app->startupWMClass();
+        entry.noDisplay = app->noDisplay();
+        entries.append(std::move(entry));
+    }
+
+    const auto count = entries.size();
+    const auto filePath = applicationIndexFilePath();
+    if (!ApplicationIndexWriter::publish(filePath, std::move(entries), QDateTime::currentMSecsSinceEpoch())) {
+        qCWarning(DDEAM) << "failed to publish application index, clients will fall back to D-Bus.";
+        return;
+    }
+
+    qCDebug(DDEAM) << "published application index with" << count << "applications to" << filePath;
+}
+
+void ApplicationManager1Service::updateSearchIndex(const ApplicationService &app) noexcept
+{
+    // index both the translation of session locale and the untranslated value
+    auto values = [&app](const QString &key) {
+        QStringList ret;
+        const auto group = fromStaticRaw(DesktopFileEntryKey);
+        for (auto type : {EntryValueType::LocaleString, EntryValueType::String}) {
+            if (auto value = app.findEntryValue(group, key, type).toString(); !value.isEmpty() && !ret.contains(value)) {
+                ret.append(std::move(value));
+            }
+        }
+        return ret;
+    };
+
+    m_searchIndex.update(app.id(),
+                         SearchDocument{values(fromStaticRaw(DesktopEntryName)),
+                                        values(fromStaticRaw(DesktopEntryGenericName)),
+                                        values(fromStaticRaw(DesktopEntryKeywords)),
+                                        values(fromStaticRaw(DesktopEntryComment))});
+}
+
+QList<QDBusObjectPath> ApplicationManager1Service::Search(const QString &query, int limit) const noexcept
+{
+    const auto frecency = [this](const QString &appId) -> SearchFrecency {
+        auto app = m_applicationList.value(appId);
+        if (!app) {
+            return {};
+        }
+        return {app->launchedTimes(), app->lastLaunchedTime()};
+    };
+
+    return applicationPaths(m_searchIndex.search(query, limit, frecency));
+}
+
+void ApplicationManager1Service::updateLookupIndex(const ApplicationService &app) noexcept
+{
+    LookupKeys keys{app.startupWMClass(), {}, app.categories()};
+
+    const auto execs = app.execs();
+    QStringList programs;
+    if (auto exec = execs.constFind(fromStaticRaw(DesktopFileEntryKey)); exec != execs.cend()) {
+        if (auto args = ApplicationService::splitExecArguments(exec.value()); args) {
+            programs.append(ApplicationLookupIndex::programOf(*args));
+        }
+    }
+    programs.append(app.findEntryValue(fromStaticRaw(DesktopFileEntryKey), fromStaticRaw(DesktopEntryTryExec), EntryValueType::String)
+                        .toString());
+
+    for (const auto &program : std::as_const(programs)) {
+        if (program.isEmpty()) {
+            continue;
+        }
+
+        const auto path = QDir::isAbsolutePath(program) ? program : ExecutableIndex::instance().find(program);
+        keys.executables.append(ApplicationLookupIndex::resolveExecutable(path, m_systemdPathEnv));
+    }
+
+    m_lookupIndex.update(app.id(), std::move(keys));
+}
+
+void ApplicationManager1Service::prewarmSplashIcons() noexcept
+{
+    if (!m_splashHelper) {
+        return;
+    }
+
+    auto apps = m_applicationList.values();
+    std::sort(apps.begin(), apps.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs->launchedTimes() > rhs->launchedTimes();
+    });
+
+    QStringList iconNames;
+    for (const auto &app : std::as_const(apps)) {
+        if (iconNames.size() >= PrelaunchSplashHelper::kPrewarmLimit || app->launchedTimes() <= 0) {
+            break;
+        }
+
+        const auto icon = app->findEntryValue(fromStaticRaw(DesktopFileEntryKey), u"Icon"_s, EntryValueType::IconString);
+        if (!icon.isNull()) {
+            iconNames.append(icon.toString());
+        }
+    }
+
+    m_splashHelper->prewarm(iconNames);
+}
+
+QList<QDBusObjectPath> ApplicationManager1Service::applicationPaths(const QStringList &appIds) const noexcept
+{
+    QList<QDBusObjectPath> ret;
+    ret.reserve(appIds.size());
+    for (const auto &appId : appIds) {
+        if (auto app = m_applicationList.constFind(appId); app != m_applicationList.cend()) {
+            ret.append(app.value()->applicationPath());
+        }
+    }
+
+    return ret;
+}
+
+QList<QDBusObjectPath> ApplicationManager1Service::FindByWMClass(const QString &wmClass) const noexcept
+{
+    return applicationPaths(m_lookupIndex.findByWMClass(wmClass));
+}
+
+QList<QDBusObjectPath> ApplicationManager1Service::FindByExecutable(const QString &path) const noexcept
+{
+    if (!QDir::isAbsolutePath(path)) {
+        safe_sendErrorReply(QDBusError::InvalidArgs, "executable path must be absolute.");
+        return {};
+    }
+
+    return applicationPaths(m_lookupIndex.findByExecutable(path));
+}
+
+QList<QDBusObjectPath> ApplicationManager1Service::ListByCategory(const QString &category) const noexcept
+{
+    return applicationPaths(m_lookupIndex.listByCategory(category));
+}
+
+PropMap ApplicationManager1Service::GetIconFiles(const QStringList &appIds) noexcept
+{
+    // follow theme switches of the session, it's a no-op if the theme isn't changed
+    m_iconResolver.setThemeName(QIcon::themeName());
+
+    PropMap ret;
+    for (const auto &appId : appIds) {
+        auto app = m_applicationList.value(appId);
+        if (!app) {
+            continue;
+        }
+
+        const auto icon = app->findEntryValue(fromStaticRaw(DesktopFileEntryKey), u"Icon"_s, EntryValueType::IconString);
+        if (auto files = m_iconResolver.resolve(icon.toString()); !files.isEmpty()) {
+            ret.insert(appId, std::move(files));
+        }
+    }
+
+    return ret;
+}
+
 QList<QDBusObjectPath> ApplicationManager1Service::list() const
 {
     QList<QDBusObjectPath> paths;
@@ -628,26 +845,17 @@ QSharedPointer<ApplicationService> ApplicationManager1Service::addApplication(De
         return nullptr;
     }
 
-    auto *ptr = application.data();
-    if (auto *adaptor = new (std::nothrow) ApplicationAdaptor{ptr}; adaptor == nullptr) {
-        qCritical() << "new ApplicationAdaptor failed.";
-        return nullptr;
-    } else {
-        setAdaptorAutoRelaySignals(adaptor, false);
-    }
-
-    if (!registerObjectToDBus(ptr, application->applicationPath().path(), fromStaticRaw(ApplicationInterface))) {
+    // served by the dispatcher until a client modifies it or it gets an instance
+    if (!m_objectDispatcher->addApplication(application)) {
         return nullptr;
     }
     m_applicationList.insert(application->id(), application);
-
-    if (!m_startupPhase && !application->ensurePropertiesForwarder()) {
-        qCCritical(DDEAM) << "failed to initialize PropertiesForwarder for" << application->id();
-        return nullptr;
-    }
+    updateSearchIndex(*application);
+    updateLookupIndex(*application);
 
     if (!m_startupPhase) {
-        const auto interfaces = getChildInterfacesAndPropertiesFromObject(ptr);
+        const auto interfaces = ApplicationObjectDispatcher::interfacesAndProperties(application.data());
+        scheduleApplicationIndexUpdate();
         emit listChanged();
         emit InterfacesAdded(application->applicationPath(), interfaces);
         sendObjectManagerSignal(fromStaticRaw(DDEApplicationManager1ObjectPath),
@@ -659,11 +867,35 @@ QSharedPointer<ApplicationService> ApplicationManager1Service::addApplication(De
     return application;
 }
 
+void ApplicationManager1Service::reevaluateApplications(const QStringList &appIds) noexcept
+{
+    // overrides only affect TryExec among the checks, hidden and OnlyShowIn are kept by the desktop file
+    for (const auto &appId : appIds) {
+        if (auto app = m_applicationList.value(appId); app) {
+            if (ApplicationFilter::tryExecCheck(*app->m_entry, appId, m_sessionOverrideConfig.get())) {
+                qCInfo(DDEAM) << "application" << appId << "is hidden by session override.";
+                removeOneApplication(appId);
+            }
+            continue;
+        }
+
+        ParserError err{ParserError::NoError};
+        auto file = DesktopFile::searchDesktopFileById(appId, err);
+        if (!file) {
+            continue;
+        }
+
+        if (addApplication(std::move(file).value())) {
+            qCInfo(DDEAM) << "application" << appId << "is shown by session override.";
+        }
+    }
+}
+
 void ApplicationManager1Service::removeOneApplication(const QString &appId) noexcept
 {
     auto objectPath = QDBusObjectPath{getObjectPathFromAppId(appId)};
     if (auto it = m_applicationList.constFind(appId); it != m_applicationList.cend()) {
-        const auto interfaces = getChildInterfacesFromObject(it->data());
+        const auto interfaces = ApplicationObjectDispatcher::interfaces();
         emit InterfacesRemoved(objectPath, interfaces);
         sendObjectManagerSignal(fromStaticRaw(DDEApplicationManager1ObjectPath),
                                 "InterfacesRemoved",
@@ -675,9 +907,13 @@ void ApplicationManager1Service::removeOneApplication(const QString &appId) noex
             }
         }
         unregisterObjectFromDBus(objectPath.path());
+        m_objectDispatcher->removeApplication(objectPath.path());
+        m_searchIndex.remove(appId);
+        m_lookupIndex.remove(appId);
         std::ignore = it->data()->RemoveFromDesktop();
         m_applicationList.erase(it);
 
+        scheduleApplicationIndexUpdate();
         emit listChanged();
     }
 }
@@ -712,14 +948,7 @@ QString ApplicationManager1Service::Identify(const QDBusUnixFileDescriptor &pidf
     }
 
     auto app = m_applicationList.value(ret.ApplicationId);
-    QDBusObjectPath instancePath;
-    const auto &instances = app->instances();
-    if (ret.InstanceId.isEmpty() && instances.size() == 1) {
-        // Maybe a dbus systemd service
-        instancePath = instances.constFirst();
-    } else {
-        instancePath = app->findInstance(ret.InstanceId);
-    }
+    auto instancePath = findInstancePath(*app, ret.InstanceId);
     if (instancePath.path().isEmpty()) {
         safe_sendErrorReply(QDBusError::Failed, "can't find instance:" % ret.InstanceId);
         return {};
@@ -732,28 +961,96 @@ QString ApplicationManager1Service::Identify(const QDBusUnixFileDescriptor &pidf
     return ret.ApplicationId;
 }
 
-void ApplicationManager1Service::updateApplication(const QSharedPointer<ApplicationService> &destApp,
-                                                   DesktopFile desktopFile) noexcept
+QDBusObjectPath ApplicationManager1Service::findInstancePath(const ApplicationService &app, const QString &instanceId) noexcept
 {
-    if (!m_applicationList.contains(destApp->id())) {
-        return;
+    const auto &instances = app.instances();
+    if (instanceId.isEmpty() && instances.size() == 1) {
+        // Maybe a dbus systemd service
+        return instances.constFirst();
     }
 
-    auto *newEntry = new (std::nothrow) DesktopEntry{};
-    if (newEntry == nullptr) {
-        qCritical() << "new DesktopEntry failed.";
-        return;
+    return app.findInstance(instanceId);
+}
+
+QList<IdentifyResult> ApplicationManager1Service::IdentifyMany(const QList<QDBusUnixFileDescriptor> &pidfds) const noexcept
+{
+    Q_ASSERT_X(static_cast<bool>(m_identifier), "IdentifyMany", "Broken Identifier.");
+
+    // reading /proc dominates, so identify processes in parallel and look up applications afterwards
+    const auto rets = QtConcurrent::blockingMapped<QList<IdentifyRet>>(&m_identifyPool, pidfds, [this](const QDBusUnixFileDescriptor &pidfd) {
+        return pidfd.isValid() ? m_identifier->Identify(pidfd) : IdentifyRet{};
+    });
+
+    QList<IdentifyResult> results;
+    results.reserve(rets.size());
+    for (const auto &ret : rets) {
+        IdentifyResult result{{}, QDBusObjectPath{u"/"_s}, {}};
+        auto app = m_applicationList.value(ret.ApplicationId);
+        if (ret.ApplicationId.isEmpty()) {
+            result.error = u"Identify failed."_s;
+        } else if (!app) {
+            result.error = u"can't find application:"_s % ret.ApplicationId;
+        } else if (auto instance = findInstancePath(*app, ret.InstanceId); instance.path().isEmpty()) {
+            result.error = u"can't find instance:"_s % ret.InstanceId;
+        } else {
+            result.applicationId = ret.ApplicationId;
+            result.instance = std::move(instance);
+        }
+
+        results.append(std::move(result));
     }
 
-    auto err = newEntry->parse(desktopFile);
-    if (err != ParserError::NoError) {
-        qWarning() << "update desktop file failed:" << err << ", content wouldn't change.";
+    return results;
+}
+
+QString ApplicationManager1Service::IdentifyApplication(const QDBusUnixFileDescriptor &pidfd,
+                                                        QDBusObjectPath &instance,
+                                                        uint &confidence) const noexcept
+{
+    if (!pidfd.isValid()) {
+        safe_sendErrorReply(QDBusError::InvalidArgs, "pidfd isn't a valid unix file descriptor.");
+        return {};
+    }
+
+    Q_ASSERT_X(static_cast<bool>(m_identifier), "IdentifyApplication", "Broken Identifier.");
+
+    auto ret = m_identifier->Identify(pidfd);
+    if (ret.ApplicationId.isEmpty() || !m_applicationList.contains(ret.ApplicationId)) {
+        ret = m_executableIdentifier->Identify(pidfd);
+    }
+
+    auto app = m_applicationList.value(ret.ApplicationId);
+    if (!app) {
+        safe_sendErrorReply(QDBusError::Failed, "Identify failed.");
+        return {};
+    }
+
+    // processes matched by executable don't belong to any instance unit
+    instance = QDBusObjectPath{u"/"_s};
+    if (ret.Confidence == IdentifyConfidence::High) {
+        if (auto path = findInstancePath(*app, ret.InstanceId); !path.path().isEmpty()) {
+            instance = std::move(path);
+        }
+    }
+    confidence = static_cast<uint>(ret.Confidence);
+
+    return ret.ApplicationId;
+}
+
+void ApplicationManager1Service::updateApplication(const QSharedPointer<ApplicationService> &destApp,
+                                                   DesktopFile desktopFile,
+                                                   std::unique_ptr<DesktopEntry> newEntry) noexcept
+{
+    if (!m_applicationList.contains(destApp->id())) {
         return;
     }
 
-    if (*(destApp->m_entry) != *newEntry) {
-        destApp->resetEntry(newEntry);
+    if (newEntry && *(destApp->m_entry) != *newEntry) {
+        destApp->resetEntry(newEntry.release());
         destApp->detachAllInstance();
+        updateSearchIndex(*destApp);
+        updateLookupIndex(*destApp);
+        scheduleApplicationIndexUpdate();
     }
 
     if (destApp->m_desktopSource != desktopFile && destApp->isAutoStart()) {
@@ -764,40 +1061,164 @@ void ApplicationManager1Service::updateApplication(const QSharedPointer<Applicat
 }
 
 void ApplicationManager1Service::ReloadApplications()
+{
+    if (calledFromDBus() && message().type() == QDBusMessage::MethodCallMessage) {
+        // callers expect the applications to be reloaded once this returns, answer after the scan is applied
+        setDelayedReply(true);
+        m_reloadReplies.append(message());
+        doReloadApplications();
+        return;
+    }
+
+    // file system events and update notifications arrive in bursts while packages are installed
+    const auto delay = m_reloadScheduler.addChange(m_reloadClock.elapsed(), isPackageTransactionRunning());
+    m_reloadTimer.start(static_cast<int>(delay));
+}
+
+void ApplicationManager1Service::onReloadTimeout()
+{
+    if (m_reloadScheduler.hasPending()) {
+        if (const auto delay = m_reloadScheduler.remaining(m_reloadClock.elapsed(), isPackageTransactionRunning()); delay > 0) {
+            m_reloadTimer.start(static_cast<int>(delay));
+            return;
+        }
+    }
+
+    doReloadApplications();
+}
+
+void ApplicationManager1Service::doReloadApplications()
 {
     if (m_isReloading) {
         qInfo() << "reload already in progress, deferring.";
         m_pendingReload = true;
         return;
     }
-    if (calledFromDBus() && !m_reloadTimer.isActive()) {
-        doReloadApplications();
-        return;
+
+    m_isReloading = true;
+    m_pendingReload = false;
+    // changes reported until now are covered by this scan
+    m_reloadScheduler.reloaded();
+    m_reloadTimer.stop();
+    qInfo() << "reload applications.";
+
+    // packages may have been changed, only list files touched since last build are parsed again
+    PackageIndex::instance().refresh();
+
+    QElapsedTimer blocked;
+    blocked.start();
+
+    ApplicationSnapshot snapshot;
+    snapshot.reserve(m_applicationList.size());
+    for (auto it = m_applicationList.cbegin(); it != m_applicationList.cend(); ++it) {
+        snapshot.insert(it.key(), snapshotOf(*it.value()));
     }
-    m_reloadTimer.start();
+    const auto snapshotTime = blocked.nsecsElapsed();
+
+    // scanning and parsing don't touch the application table, the main thread keeps serving meanwhile
+    QtConcurrent::run([snapshot = std::move(snapshot), dirs = getApplicationsDirs(), target = thread()]() {
+        return scanApplicationChanges(snapshot, dirs, target);
+    }).then(this, [this, snapshotTime](std::shared_ptr<ApplicationDelta> delta) {
+        applyApplicationDelta(*delta, snapshotTime);
+    });
 }
 
-void ApplicationManager1Service::doReloadApplications()
+void ApplicationManager1Service::onApplicationFilesUpdated(const QStringList &paths)
 {
+    // the package manager knows which desktop files it touched, only those ids are looked up again
+    if (paths.isEmpty()) {
+        // no desktop file changed, but triggers of the run may have rewritten mimeinfo.cache or icons
+        if (m_reloadScheduler.coverTransaction()) {
+            m_reloadTimer.stop();
+            reloadApplicationResources();
+        }
+        return;
+    }
+
+    if (m_isReloading || paths.size() > MaxTargetedReloadFiles) {
+        ReloadApplications();
+        return;
+    }
+
+    const auto &dirs = getApplicationsDirs();
+    QStringList relativePaths;
+    relativePaths.reserve(paths.size());
+    for (const auto &path : paths) {
+        auto dir = std::find_if(dirs.cbegin(), dirs.cend(), [&path](const QString &applicationsDir) {
+            return path.startsWith(applicationsDir) && path.size() > applicationsDir.size() &&
+                   path.at(applicationsDir.size()) == QDir::separator();
+        });
+        if (dir == dirs.cend()) {
+            qCInfo(DDEAM) << path << "isn't in any application directory, fall back to a full reload.";
+            ReloadApplications();
+            return;
+        }
+        relativePaths.append(QDir{*dir}.relativeFilePath(path));
+    }
+
+    if (m_reloadScheduler.coverTransaction()) {
+        m_reloadTimer.stop();
+    }
+
     m_isReloading = true;
     m_pendingReload = false;
-    qInfo() << "reload applications.";
+    qInfo() << "reload applications of" << relativePaths.size() << "desktop files.";
 
-    auto appIds = m_applicationList.keys();
+    PackageIndex::instance().refresh();
 
-    forEachApplicationDesktopFile([this, &appIds](DesktopFile file) -> bool {
-        auto app = m_applicationList.value(file.desktopId());
-        if (app && appIds.contains(app->id())) {
-            appIds.removeOne(app->id());
-            updateApplication(app, std::move(file));
-            return false;
+    QElapsedTimer blocked;
+    blocked.start();
+
+    ApplicationSnapshot snapshot;
+    for (const auto &relativePath : std::as_const(relativePaths)) {
+        const auto id = desktopIdFromRelativePath(relativePath);
+        if (auto app = m_applicationList.constFind(id); app != m_applicationList.cend()) {
+            snapshot.insert(id, snapshotOf(*app.value()));
         }
+    }
+    const auto snapshotTime = blocked.nsecsElapsed();
 
-        addApplication(std::move(file));
-        return false;
+    QtConcurrent::run([snapshot = std::move(snapshot), relativePaths = std::move(relativePaths), dirs, target = thread()]() {
+        return scanApplicationFiles(snapshot, relativePaths, dirs, target);
+    }).then(this, [this, snapshotTime](std::shared_ptr<ApplicationDelta> delta) {
+        applyApplicationDelta(*delta, snapshotTime);
     });
+}
+
+ApplicationSnapshotEntry ApplicationManager1Service::snapshotOf(const ApplicationService &app) noexcept
+{
+    const auto &source = app.desktopFileSource();
+    return {source.sourcePath(), source.modifiedTime(), source.createTime(), app.m_entry ? *app.m_entry : DesktopEntry{}};
+}
+
+void ApplicationManager1Service::applyApplicationDelta(ApplicationDelta &delta, qint64 blockedNsecs) noexcept
+{
+    QElapsedTimer blocked;
+    blocked.start();
+
+    qInfo() << "apply reloaded applications, added:" << delta.added.size() << "changed:" << delta.changed.size()
+            << "touched:" << delta.touched.size() << "removed:" << delta.removed.size();
+
+    // the table may have been changed while scanning, fall back to adding if an application is gone
+    for (auto &[file, entry] : delta.changed) {
+        if (auto app = m_applicationList.value(file.desktopId()); app) {
+            updateApplication(app, std::move(file), std::move(entry));
+        } else {
+            addApplication(std::move(file), std::move(entry));
+        }
+    }
+
+    for (auto &file : delta.touched) {
+        if (auto app = m_applicationList.value(file.desktopId()); app) {
+            updateApplication(app, std::move(file), nullptr);
+        }
+    }
+
+    for (auto &[file, entry] : delta.added) {
+        addApplication(std::move(file), std::move(entry));
+    }
 
-    for (const auto &appId : std::as_const(appIds)) {
+    for (const auto &appId : std::as_const(delta.removed)) {
         removeOneApplication(appId);
     }
 
@@ -805,22 +1226,56 @@ void ApplicationManager1Service::doReloadApplications()
 
     m_sessionOverrideConfig->preload(m_applicationList.keys());
 
-    reloadMimeInfos();
+    reloadApplicationResources();
 
     EventReporter::instance().initialize();
 
+    const auto blockedUsecs = (blockedNsecs + blocked.nsecsElapsed()) / 1000;
+    m_reloadStatistics.reloads += 1;
+    m_reloadStatistics.lastBlockedUsecs = blockedUsecs;
+    m_reloadStatistics.maxBlockedUsecs = std::max(m_reloadStatistics.maxBlockedUsecs, blockedUsecs);
+    m_reloadStatistics.totalBlockedUsecs += blockedUsecs;
+    qCInfo(DDEAM) << "reload applications blocked main thread for" << blockedUsecs << "us.";
+
     m_isReloading = false;
 
     if (m_pendingReload) {
         m_pendingReload = false;
-        qInfo() << "pending reload detected, scheduling deferred reload.";
-        m_reloadTimer.start();
+        qInfo() << "pending reload detected, reloading again.";
+        doReloadApplications();
+        return;
+    }
+
+    // changes which arrived while scanning keep their own debounce window on m_reloadTimer
+    for (const auto &request : std::exchange(m_reloadReplies, {})) {
+        ApplicationManager1DBus::instance().globalServerBus().send(request.createReply());
     }
 }
 
+void ApplicationManager1Service::reloadApplicationResources() noexcept
+{
+    reloadMimeInfos();
+
+    if (m_splashHelper) {
+        // icon files may have been installed or removed along with applications
+        m_splashHelper->invalidateIconCache();
+        prewarmSplashIcons();
+    }
+}
+
+QVariantMap ApplicationManager1Service::reloadStatistics() const noexcept
+{
+    return {{u"Reloads"_s, m_reloadStatistics.reloads},
+            {u"LastBlockedUsecs"_s, m_reloadStatistics.lastBlockedUsecs},
+            {u"MaxBlockedUsecs"_s, m_reloadStatistics.maxBlockedUsecs},
+            {u"TotalBlockedUsecs"_s, m_reloadStatistics.totalBlockedUsecs},
+            {u"ChangeEvents"_s, m_reloadScheduler.changes()},
+            {u"SavedReloads"_s, m_reloadScheduler.savedReloads()}};
+}
+
 ObjectMap ApplicationManager1Service::GetManagedObjects() const
 {
-    return dumpDBusObject(m_applicationList);
+    return ApplicationObjectDispatcher::dumpApplications(m_applicationList.values());
 }
 
 QHash<QDBusObjectPath, QSharedPointer<ApplicationService>>
@@ -6,6 +6,7 @@
 #define APPLICATIONMANAGER1SERVICE_H
 
 #include <QObject>
+#include <QDBusMessage>
 #include <QDBusObjectPath>
 #include <QDBusUnixFileDescriptor>
 #include <QSharedPointer>
@@ -13,8 +14,14 @@
 #include <QMap>
 #include <QHash>
 #include <QFileSystemWatcher>
+#include <QElapsedTimer>
 #include <QTimer>
+#include <QThreadPool>
 #include "applicationmanagerstorage.h"
+#include "applicationlookupindex.h"
+#include "iconthemeresolver.h"
+#include "applicationsearchindex.h"
+#include "reloadscheduler.h"
 #include "dbus/jobmanager1service.h"
 #include "dbus/mimemanager1service.h"
 #include "desktopentry.h"
@@ -26,36 +33,9 @@
 Q_DECLARE_LOGGING_CATEGORY(DDEAM)
 
 class ApplicationService;
-
-class UnitResultWatcher : public QObject
-{
-    Q_OBJECT
-public:
-    explicit UnitResultWatcher(const QDBusObjectPath &unitPath, QObject *parent = nullptr)
-        : QObject(parent), m_unitPath(unitPath) {}
-
-public Q_SLOTS:
-    void handlePropertyChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
-    {
-        if (interface != QStringLiteral("org.freedesktop.systemd1.Unit")
-            && interface != QStringLiteral("org.freedesktop.systemd1.Service")) {
-            return;
-        }
-
-        if (auto it = changed.constFind(QStringLiteral("Result")); it != changed.constEnd()) {
-            auto result = it.value().toString();
-            if (!result.isEmpty() && result != QStringLiteral("success")) {
-                emit resultReady(m_unitPath, result);
-            }
-        }
-    }
-
-Q_SIGNALS:
-    void resultReady(const QDBusObjectPath &unitPath, const QString &result);
-
-private:
-    QDBusObjectPath m_unitPath;
-};
+class ApplicationObjectDispatcher;
+struct ApplicationDelta;
+struct ApplicationSnapshotEntry;
 
 class ApplicationManager1Service final : public QObject, protected QDBusContext
 {
@@ -74,6 +54,9 @@ public:
     Q_PROPERTY(QList<QDBusObjectPath> List READ list NOTIFY listChanged)
     [[nodiscard]] QList<QDBusObjectPath> list() const;
 
+    Q_PROPERTY(QVariantMap ReloadStatistics READ reloadStatistics)
+    [[nodiscard]] QVariantMap reloadStatistics() const noexcept;
+
     void initService(QDBusConnection &connection) noexcept;
     void reloadMimeInfos() noexcept;
     QSharedPointer<ApplicationService> addApplication(DesktopFile desktopFileSource) noexcept;
@@ -81,7 +64,10 @@ public:
     void removeAllApplication() noexcept;
     [[nodiscard]] QHash<QDBusObjectPath, QSharedPointer<ApplicationService>>
     findApplicationsByIds(const QStringList &appIds) const noexcept;
-    void updateApplication(const QSharedPointer<ApplicationService> &destApp, DesktopFile desktopFile) noexcept;
+    // newEntry is nullptr if only the source file is replaced
+    void updateApplication(const QSharedPointer<ApplicationService> &destApp,
+                           DesktopFile desktopFile,
+                           std::unique_ptr<DesktopEntry> newEntry) noexcept;
 
     [[nodiscard]] const auto &Applications() const noexcept { return m_applicationList; }
     [[nodiscard]] JobManager1Service &jobManager() noexcept { return *m_jobManager; }
@@ -106,7 +92,14 @@ public Q_SLOTS:
     QString Identify(const QDBusUnixFileDescriptor &pidfd,
                      QDBusObjectPath &instance,
                      ObjectInterfaceMap &application_instance_info) const noexcept;
+    [[nodiscard]] QList<IdentifyResult> IdentifyMany(const QList<QDBusUnixFileDescriptor> &pidfds) const noexcept;
+    QString IdentifyApplication(const QDBusUnixFileDescriptor &pidfd, QDBusObjectPath &instance, uint &confidence) const noexcept;
     void ReloadApplications();
+    [[nodiscard]] QList<QDBusObjectPath> Search(const QString &query, int limit) const noexcept;
+    [[nodiscard]] QList<QDBusObjectPath> FindByWMClass(const QString &wmClass) const noexcept;
+    [[nodiscard]] QList<QDBusObjectPath> FindByExecutable(const QString &path) const noexcept;
+    [[nodiscard]] QList<QDBusObjectPath> ListByCategory(const QString &category) const noexcept;
+    [[nodiscard]] PropMap GetIconFiles(const QStringList &appIds) noexcept;
     QString addUserApplication(const QVariantMap &desktop_file, const QString &name) noexcept;
     void deleteUserApplication(const QString &app_id) noexcept;
     [[nodiscard]] ObjectMap GetManagedObjects() const;
@@ -118,30 +111,63 @@ Q_SIGNALS:
 
 private Q_SLOTS:
     void doReloadApplications();
+    void onReloadTimeout();
+    void onApplicationFilesUpdated(const QStringList &paths);
 
 private:
     bool m_startupPhase{true};
     bool m_isNewSession{false};
     std::unique_ptr<Identifier> m_identifier;
+    std::unique_ptr<Identifier> m_executableIdentifier;
+    // IdentifyMany waits on these workers, so they must not be shared with launch jobs or sniffing
+    mutable QThreadPool m_identifyPool;
     std::weak_ptr<ApplicationManager1Storage> m_storage;
     std::unique_ptr<MimeManager1Service> m_mimeManager;
+    std::unique_ptr<ApplicationObjectDispatcher> m_objectDispatcher;
     std::unique_ptr<JobManager1Service> m_jobManager;
     QStringList m_hookElements;
     QStringList m_systemdPathEnv;
     QFileSystemWatcher m_watcher;
     QTimer m_reloadTimer;
+    QElapsedTimer m_reloadClock;
+    ReloadScheduler m_reloadScheduler;
+    QTimer m_indexTimer;
     bool m_isReloading{false};
     bool m_pendingReload{false};
+    struct ReloadStatistics
+    {
+        quint64 reloads{0};
+        qint64 lastBlockedUsecs{0};
+        qint64 maxBlockedUsecs{0};
+        qint64 totalBlockedUsecs{0};
+    } m_reloadStatistics;
+    QList<QDBusMessage> m_reloadReplies;
     QHash<QString, QSharedPointer<ApplicationService>> m_applicationList;
+    ApplicationSearchIndex m_searchIndex;
+    ApplicationLookupIndex m_lookupIndex;
+    IconThemeResolver m_iconResolver;
     QSharedPointer<CompatibilityManager> m_compatibilityManager;
     std::unique_ptr<SessionOverrideConfig> m_sessionOverrideConfig;
     std::unique_ptr<PrelaunchSplashHelper> m_splashHelper;
 
     void scanMimeInfos() noexcept;
     void scanApplications() noexcept;
+    // blockedNsecs is the time the main thread has spent on this reload before the scan
+    void applyApplicationDelta(ApplicationDelta &delta, qint64 blockedNsecs) noexcept;
+    [[nodiscard]] static ApplicationSnapshotEntry snapshotOf(const ApplicationService &app) noexcept;
+    // MIME and icon data installed along with applications
+    void reloadApplicationResources() noexcept;
     void scanInstances() noexcept;
     void updateAutostartStatus() noexcept;
     void loadHooks() noexcept;
+    void scheduleApplicationIndexUpdate() noexcept;
+    void publishApplicationIndex() noexcept;
+    void updateSearchIndex(const ApplicationService &app) noexcept;
+    void updateLookupIndex(const ApplicationService &app) noexcept;
+    void prewarmSplashIcons() noexcept;
+    void reevaluateApplications(const QStringList &appIds) noexcept;
+    [[nodiscard]] QList<QDBusObjectPath> applicationPaths(const QStringList &appIds) const noexcept;
+    [[nodiscard]] static QDBusObjectPath findInstancePath(const ApplicationService &app, const QString &instanceId) noexcept;
     void onUnitNew(const QString &unitName, const QDBusObjectPath &systemdUnitPath) noexcept;
     void onUnitRemoved(const QString &unitName, const QDBusObjectPath &systemdUnitPath) noexcept;
     QSharedPointer<ApplicationService> addApplication(DesktopFile desktopFileSource, std::unique_ptr<DesktopEntry> entry) noexcept;
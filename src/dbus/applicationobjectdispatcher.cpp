@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbus/applicationobjectdispatcher.h"
+#include "APPobjectmanager1adaptor.h"
+#include "applicationadaptor.h"
+#include "dbus/applicationservice.h"
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusVariant>
+#include <QMetaClassInfo>
+#include <QMetaProperty>
+#include <QStringBuilder>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+QString introspectionOf(const QMetaObject &mo) noexcept
+{
+    auto index = mo.indexOfClassInfo("D-Bus Introspection");
+    if (index == -1) {
+        return {};
+    }
+
+    return QString::fromUtf8(mo.classInfo(index).value());
+}
+
+QMetaProperty findApplicationProperty(const QString &name) noexcept
+{
+    const auto &mo = ApplicationAdaptor::staticMetaObject;
+    auto index = mo.indexOfProperty(name.toUtf8().constData());
+    if (index < mo.propertyOffset()) {
+        return {};
+    }
+
+    return mo.property(index);
+}
+
+bool isApplicationInterface(const QString &interface) noexcept
+{
+    return interface.isEmpty() || interface == fromStaticRaw(ApplicationInterface);
+}
+}  // namespace
+
+ApplicationObjectDispatcher::ApplicationObjectDispatcher(QObject *parent)
+    : QDBusVirtualObject(parent)
+{
+}
+
+bool ApplicationObjectDispatcher::addApplication(const QSharedPointer<ApplicationService> &app) noexcept
+{
+    const auto &path = app->applicationPath().path();
+    if (!registerVirtualObjectToDBus(this, path)) {
+        return false;
+    }
+
+    m_applications.insert(path, app);
+    return true;
+}
+
+void ApplicationObjectDispatcher::removeApplication(const QString &path) noexcept
+{
+    m_applications.remove(path);
+}
+
+ObjectInterfaceMap ApplicationObjectDispatcher::interfacesAndProperties(const ApplicationService *app) noexcept
+{
+    if (Q_UNLIKELY(app == nullptr)) {
+        qCCritical(DDEAMUtils) << "application pointer is nullptr";
+        return {};
+    }
+
+    const auto &mo = ApplicationAdaptor::staticMetaObject;
+    QVariantMap properties;
+    for (auto i = mo.propertyOffset(); i < mo.propertyCount(); ++i) {
+        const auto *name = mo.property(i).name();
+        properties.insert(QString::fromUtf8(name), app->property(name));
+    }
+
+    return {{getDBusInterface(&ApplicationAdaptor::staticMetaObject), properties},
+            {getDBusInterface(&APPObjectManagerAdaptor::staticMetaObject), QVariantMap{}}};
+}
+
+QStringList ApplicationObjectDispatcher::interfaces() noexcept
+{
+    return {getDBusInterface(&ApplicationAdaptor::staticMetaObject),
+            getDBusInterface(&APPObjectManagerAdaptor::staticMetaObject)};
+}
+
+ObjectMap ApplicationObjectDispatcher::dumpApplications(const QList<QSharedPointer<ApplicationService>> &apps) noexcept
+{
+    ObjectMap objs;
+    for (const auto &app : apps) {
+        objs.insert(app->applicationPath(), interfacesAndProperties(app.data()));
+    }
+
+    return objs;
+}
+
+QString ApplicationObjectDispatcher::introspect([[maybe_unused]] const QString &path) const
+{
+    // Properties, Introspectable, Peer and the child nodes are appended by QtDBus.
+    return introspectionOf(ApplicationAdaptor::staticMetaObject) + introspectionOf(APPObjectManagerAdaptor::staticMetaObject);
+}
+
+bool ApplicationObjectDispatcher::handleMessage(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    if (message.type() != QDBusMessage::MethodCallMessage) {
+        return false;
+    }
+
+    auto app = m_applications.value(message.path()).toStrongRef();
+    if (!app) {
+        return false;
+    }
+
+    const auto &interface = message.interface();
+    if (interface == fromStaticRaw(SystemdPropInterfaceName)) {
+        return handlePropertiesCall(app, message, connection);
+    }
+
+    if (interface == fromStaticRaw(ObjectManagerInterface) && message.member() == u"GetManagedObjects"_s) {
+        // instances are only registered under materialized applications
+        return connection.send(message.createReply(QVariant::fromValue(app->GetManagedObjects())));
+    }
+
+    if (isApplicationInterface(interface)) {
+        return handleApplicationCall(app, message, connection);
+    }
+
+    return false;
+}
+
+bool ApplicationObjectDispatcher::handlePropertiesCall(const QSharedPointer<ApplicationService> &app,
+                                                       const QDBusMessage &message,
+                                                       const QDBusConnection &connection) noexcept
+{
+    const auto &member = message.member();
+    const auto &args = message.arguments();
+    if (args.isEmpty()) {
+        return false;
+    }
+
+    const auto interface = args.constFirst().toString();
+    if (member == u"GetAll"_s) {
+        if (interface == fromStaticRaw(ObjectManagerInterface)) {
+            return connection.send(message.createReply(QVariant::fromValue(QVariantMap{})));
+        }
+
+        if (!isApplicationInterface(interface)) {
+            return connection.send(message.createErrorReply(QDBusError::UnknownInterface, "unknown interface:" % interface));
+        }
+
+        auto interfaces = interfacesAndProperties(app.data());
+        return connection.send(message.createReply(QVariant::fromValue(interfaces.value(fromStaticRaw(ApplicationInterface)))));
+    }
+
+    if (args.size() < 2 || !isApplicationInterface(interface)) {
+        return connection.send(message.createErrorReply(QDBusError::InvalidArgs, "unknown interface:" % interface));
+    }
+
+    const auto name = args.at(1).toString();
+    const auto prop = findApplicationProperty(name);
+    if (!prop.isValid()) {
+        return connection.send(message.createErrorReply(QDBusError::UnknownProperty, "unknown property:" % name));
+    }
+
+    if (member == u"Get"_s) {
+        return connection.send(message.createReply(QVariant::fromValue(QDBusVariant{app->property(prop.name())})));
+    }
+
+    if (member != u"Set"_s || args.size() < 3) {
+        return false;
+    }
+
+    if (!prop.isWritable()) {
+        return connection.send(message.createErrorReply(QDBusError::PropertyReadOnly, "property is read-only:" % name));
+    }
+
+    auto value = qvariant_cast<QDBusVariant>(args.at(2)).variant();
+    if (value.metaType() == QMetaType::fromType<QDBusArgument>()) {
+        QVariant converted{prop.metaType()};
+        if (!QDBusMetaType::demarshall(qvariant_cast<QDBusArgument>(value), prop.metaType(), converted.data())) {
+            return connection.send(message.createErrorReply(QDBusError::InvalidSignature, "invalid value of property:" % name));
+        }
+        value = std::move(converted);
+    }
+
+    QDBusError error;
+    const auto written = app->captureErrors(error, [&app, &prop, &value] { return app->setProperty(prop.name(), value); });
+    if (error.isValid()) {
+        return connection.send(message.createErrorReply(error));
+    }
+
+    if (!written) {
+        return connection.send(message.createErrorReply(QDBusError::InvalidArgs, "failed to set property:" % name));
+    }
+
+    auto changed = QDBusMessage::createSignal(message.path(), fromStaticRaw(SystemdPropInterfaceName), u"PropertiesChanged"_s);
+    changed << fromStaticRaw(ApplicationInterface) << QVariantMap{{name, app->property(prop.name())}} << QStringList{};
+
+    scheduleMaterialize(app);
+    return connection.send(message.createReply()) && connection.send(changed);
+}
+
+bool ApplicationObjectDispatcher::handleApplicationCall(const QSharedPointer<ApplicationService> &app,
+                                                        const QDBusMessage &message,
+                                                        const QDBusConnection &connection) noexcept
+{
+    const auto &member = message.member();
+    const auto &args = message.arguments();
+
+    if (member == u"Launch"_s) {
+        if (args.size() != 3) {
+            return connection.send(message.createErrorReply(QDBusError::InvalidArgs, u"Launch expects (s, as, a{sv})."_s));
+        }
+
+        QDBusError error;
+        auto job = app->launch(args.at(0).toString(), qdbus_cast<QStringList>(args.at(1)), qdbus_cast<QVariantMap>(args.at(2)), error);
+        if (error.isValid()) {
+            return connection.send(message.createErrorReply(error));
+        }
+
+        if (job.path().isEmpty()) {
+            return connection.send(message.createErrorReply(QDBusError::Failed, "launch " % app->id() % " failed."));
+        }
+
+        // instances of the launched application will be exported under the materialized object
+        scheduleMaterialize(app);
+        return connection.send(message.createReply(QVariant::fromValue(job)));
+    }
+
+    if (member == u"SendToDesktop"_s || member == u"RemoveFromDesktop"_s) {
+        QDBusError error;
+        auto ret = app->captureErrors(error, [&app, &member] {
+            return member == u"SendToDesktop"_s ? app->SendToDesktop() : app->RemoveFromDesktop();
+        });
+        scheduleMaterialize(app);
+        return connection.send(error.isValid() ? message.createErrorReply(error) : message.createReply(ret));
+    }
+
+    return false;
+}
+
+void ApplicationObjectDispatcher::scheduleMaterialize(const QSharedPointer<ApplicationService> &app) noexcept
+{
+    // QtDBus still holds the virtual node while we are handling a message, swap it out afterwards.
+    QMetaObject::invokeMethod(
+        this,
+        [this, weak = app.toWeakRef()]() {
+            auto app = weak.toStrongRef();
+            if (!app) {
+                return;
+            }
+
+            if (!app->ensureMaterialized()) {
+                qCWarning(DDEAMUtils) << "failed to materialize application" << app->id();
+                return;
+            }
+
+            m_applications.remove(app->applicationPath().path());
+        },
+        Qt::QueuedConnection);
+}
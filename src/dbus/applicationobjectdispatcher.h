@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef APPLICATIONOBJECTDISPATCHER_H
+#define APPLICATIONOBJECTDISPATCHER_H
+
+#include "global.h"
+#include <QDBusVirtualObject>
+#include <QHash>
+#include <QSharedPointer>
+#include <QWeakPointer>
+
+class ApplicationService;
+
+// Serves every application object which hasn't been materialized yet.
+// Reads (Properties.Get/GetAll, Introspect) and Launch are answered straight from the
+// application table, anything that mutates an application materializes its real object.
+class ApplicationObjectDispatcher : public QDBusVirtualObject
+{
+    Q_OBJECT
+public:
+    explicit ApplicationObjectDispatcher(QObject *parent = nullptr);
+    ~ApplicationObjectDispatcher() override = default;
+    ApplicationObjectDispatcher(const ApplicationObjectDispatcher &) = delete;
+    ApplicationObjectDispatcher(ApplicationObjectDispatcher &&) = delete;
+    ApplicationObjectDispatcher &operator=(const ApplicationObjectDispatcher &) = delete;
+    ApplicationObjectDispatcher &operator=(ApplicationObjectDispatcher &&) = delete;
+
+    bool addApplication(const QSharedPointer<ApplicationService> &app) noexcept;
+    void removeApplication(const QString &path) noexcept;
+
+    [[nodiscard]] static ObjectInterfaceMap interfacesAndProperties(const ApplicationService *app) noexcept;
+    [[nodiscard]] static QStringList interfaces() noexcept;
+    [[nodiscard]] static ObjectMap dumpApplications(const QList<QSharedPointer<ApplicationService>> &apps) noexcept;
+
+    [[nodiscard]] QString introspect(const QString &path) const override;
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override;
+
+private:
+    QHash<QString, QWeakPointer<ApplicationService>> m_applications;
+
+    bool handlePropertiesCall(const QSharedPointer<ApplicationService> &app,
+                              const QDBusMessage &message,
+                              const QDBusConnection &connection) noexcept;
+    bool handleApplicationCall(const QSharedPointer<ApplicationService> &app,
+                               const QDBusMessage &message,
+                               const QDBusConnection &connection) noexcept;
+    void scheduleMaterialize(const QSharedPointer<ApplicationService> &app) noexcept;
+};
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "dbus/applicationservice.h"
 #include "APPobjectmanager1adaptor.h"
+#include "abnormalexitcollector.h"
+#include "applicationadaptor.h"
 #include "applicationchecker.h"
 #include "applicationmanagerstorage.h"
 #include "config.h"
@@ -299,6 +301,42 @@ bool ApplicationService::ensurePropertiesForwarder() noexcept
     return true;
 }
 
+bool ApplicationService::ensureMaterialized() noexcept
+{
+    if (m_materialized) {
+        return true;
+    }
+
+    auto *adaptor = new (std::nothrow) ApplicationAdaptor{this};
+    auto *objectManager = new (std::nothrow) APPObjectManagerAdaptor{this};
+    if (adaptor == nullptr || objectManager == nullptr) {
+        qCritical() << "new adaptors of Application failed.";
+        delete adaptor;
+        delete objectManager;
+        return false;
+    }
+
+    setAdaptorAutoRelaySignals(adaptor, false);
+    setAdaptorAutoRelaySignals(objectManager, false);
+
+    // take over the path from ApplicationObjectDispatcher
+    unregisterObjectFromDBus(m_applicationPath.path());
+    if (!registerObjectToDBus(this, m_applicationPath.path(), fromStaticRaw(ApplicationInterface))) {
+        qCritical() << "failed to materialize application" << id() << ", it's unreachable until next reload.";
+        adaptor->deleteLater();
+        objectManager->deleteLater();
+        return false;
+    }
+
+    m_materialized = true;
+    if (const auto *manager = parent(); manager != nullptr && manager->isStartupPhase()) {
+        // forwarders of materialized applications are created once the startup phase is over
+        return true;
+    }
+
+    return ensurePropertiesForwarder();
+}
+
 QSharedPointer<ApplicationService> ApplicationService::createApplicationService(
     DesktopFile source, ApplicationManager1Service *parent, std::weak_ptr<ApplicationManager1Storage> storage) noexcept
 {
@@ -346,13 +384,6 @@ QSharedPointer<ApplicationService> ApplicationService::createApplicationService(
     app->m_applicationPath = QDBusObjectPath{std::move(objectPath)};
 
     // TODO: icon lookup
-    if (auto *ptr = new (std::nothrow) APPObjectManagerAdaptor{app.data()}; ptr == nullptr) {
-        qCritical() << "new Object Manager of Application failed.";
-        return nullptr;
-    } else {
-        setAdaptorAutoRelaySignals(ptr, false);
-    }
-
     return app;
 }
 
@@ -377,6 +408,18 @@ bool ApplicationService::shouldBeShown(const std::unique_ptr<DesktopEntry> &entr
 }
 
 QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringList &fields, const QVariantMap &options)
+{
+    QDBusError error;
+    auto job = launch(action, fields, options, error);
+    if (error.isValid()) {
+        safe_sendErrorReply(error.name(), error.message());
+    }
+
+    return job;
+}
+
+QDBusObjectPath
+ApplicationService::launch(const QString &action, const QStringList &fields, const QVariantMap &options, QDBusError &error)
 {
     // Suppress splash for system autostart launches or singleton apps with existing instances.
     const bool isAutostartLaunch = options.value(fromStaticRaw(BuiltInAutostartOption), false).toBool();
@@ -395,7 +438,7 @@ QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringL
 
     if (isAutostartLaunch) {
         if (!parent()->isNewSession()) {
-            safe_sendErrorReply(QDBusError::Failed, "autostart launch has been ignored if not new session.");
+            error = QDBusError{QDBusError::Failed, u"autostart launch has been ignored if not new session."_s};
         }
     }
 
@@ -426,7 +469,7 @@ QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringL
                    << "isAutostartLaunch:" << isAutostartLaunch
                    << "desktopSource:" << m_desktopSource.sourcePath()
                    << "autostartSource:" << m_autostartSource.m_filePath;
-        safe_sendErrorReply(QDBusError::Failed, msg);
+        error = QDBusError{QDBusError::Failed, msg};
         return {};
     }
 
@@ -456,7 +499,7 @@ QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringL
         if (!Actions) {
             const QString msg{"application can't be executed."};
             qWarning() << msg;
-            safe_sendErrorReply(QDBusError::Failed, msg);
+            error = QDBusError{QDBusError::Failed, msg};
             return {};
         }
 
@@ -464,7 +507,7 @@ QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringL
         if (execStr.isEmpty()) {
             const QString msg{"maybe entry actions's format is invalid, abort launch."};
             qWarning() << msg;
-            safe_sendErrorReply(QDBusError::Failed, msg);
+            error = QDBusError{QDBusError::Failed, msg};
             return {};
         }
     }
@@ -512,13 +555,13 @@ QDBusObjectPath ApplicationService::Launch(const QString &action, const QStringL
     auto cmds = generateCommand(optionsMap);
     auto task = processExec(execStr, fields);
     if (!task) {
-        safe_sendErrorReply(QDBusError::InternalError, "Invalid Command.");
+        error = QDBusError{QDBusError::InternalError, u"Invalid Command."_s};
         return {};
     }
 
     if (task.LaunchBin.isEmpty()) {
         qCritical() << "error command is detected, abort.";
-        safe_sendErrorReply(QDBusError::Failed);
+        error = QDBusError{QDBusError::Failed, u"error command is detected."_s};
         return {};
     }
 
@@ -676,7 +719,7 @@ bool ApplicationService::SendToDesktop() const noexcept
     auto success = m_desktopSource.sourceFileRef().link(desktopFile);
     if (!success) {
         qDebug() << "create link failed:" << m_desktopSource.sourceFileRef().errorString() << "path:" << desktopFile;
-        safe_sendErrorReply(QDBusError::ErrorType::Failed, m_desktopSource.sourceFileRef().errorString());
+        sendError(QDBusError::ErrorType::Failed, m_desktopSource.sourceFileRef().errorString());
     }
 
     return success;
@@ -699,7 +742,7 @@ bool ApplicationService::RemoveFromDesktop() const noexcept
 
     if (!success) {
         qDebug() << "remove desktop file failed:" << desktopFile.errorString();
-        safe_sendErrorReply(QDBusError::ErrorType::Failed, desktopFile.errorString());
+        sendError(QDBusError::ErrorType::Failed, desktopFile.errorString());
     }
 
     return success;
@@ -949,7 +992,7 @@ void ApplicationService::setEnviron(const QString &value) noexcept
     auto storagePtr = m_storage.lock();
     if (!storagePtr) {
         qCritical() << "broken storage.";
-        safe_sendErrorReply(QDBusError::InternalError);
+        sendError(QDBusError::InternalError);
         return;
     }
 
@@ -957,13 +1000,13 @@ void ApplicationService::setEnviron(const QString &value) noexcept
     if (!storagePtr->readApplicationValue(appId, fromStaticRaw(ApplicationPropertiesGroup), fromStaticRaw(Environ)).isNull()) {
         if (!storagePtr->updateApplicationValue(
                 appId, fromStaticRaw(ApplicationPropertiesGroup), fromStaticRaw(Environ), value)) {
-            safe_sendErrorReply(QDBusError::Failed, "update environ failed.");
+            sendError(QDBusError::Failed, "update environ failed.");
             return;
         }
     } else {
         if (!storagePtr->createApplicationValue(
                 appId, fromStaticRaw(ApplicationPropertiesGroup), fromStaticRaw(Environ), value)) {
-            safe_sendErrorReply(QDBusError::Failed, "set environ failed.");
+            sendError(QDBusError::Failed, "set environ failed.");
         }
     }
 
@@ -1087,14 +1130,14 @@ void ApplicationService::setAutoStart(bool autostart) noexcept
 
     if (!m_entry) {
         qWarning() << "set autostart failed, desktop entry is null:" << id();
-        safe_sendErrorReply(QDBusError::InternalError);
+        sendError(QDBusError::InternalError);
         return;
     }
 
     const QDir startDir(getAutoStartDirs().constFirst());
     if (!startDir.exists() && !startDir.mkpath(startDir.path())) {
         qWarning() << "mkpath " << startDir.path() << "failed";
-        safe_sendErrorReply(QDBusError::InternalError);
+        sendError(QDBusError::InternalError);
         return;
     }
 
@@ -1122,7 +1165,7 @@ void ApplicationService::setAutoStart(bool autostart) noexcept
 
     if (!saveAutostartEntry(fileName, newEntry)) {
         qWarning() << "set autostart failed:" << id() << "autostart:" << autostart << "file:" << fileName;
-        safe_sendErrorReply(QDBusError::Failed);
+        sendError(QDBusError::Failed);
         return;
     }
 
@@ -1194,7 +1237,7 @@ void ApplicationService::setMimeTypes(const QStringList &value) noexcept
     auto userInfo =
         std::find_if(infos.begin(), infos.end(), [&userDir](const MimeInfo &info) { return info.directory() == userDir; });
     if (userInfo == infos.cend()) {
-        safe_sendErrorReply(QDBusError::Failed, "user-specific config file doesn't exists.");
+        sendError(QDBusError::Failed, "user-specific config file doesn't exists.");
         return;
     }
 
@@ -1202,7 +1245,7 @@ void ApplicationService::setMimeTypes(const QStringList &value) noexcept
     auto list = std::find_if(
         userAppsList.begin(), userAppsList.end(), [](const MimeApps &config) { return !config.isDesktopSpecific(); });
     if (list == userAppsList.end()) {
-        safe_sendErrorReply(QDBusError::Failed, "user-specific config file doesn't exists.");
+        sendError(QDBusError::Failed, "user-specific config file doesn't exists.");
         return;
     }
     const auto &appId = id();
@@ -1212,9 +1255,12 @@ void ApplicationService::setMimeTypes(const QStringList &value) noexcept
     for (const auto &remove : std::as_const(newRemoved)) {
         list->removeAssociation(remove, appId);
     }
+    parent()->mimeManager().updateResolution(*list);
 
     if (!list->writeToFile()) {
         qWarning() << "error occurred when write mime association to file";
+    } else {
+        list->updateStamp();
     }
 
     emit MimeTypesChanged();
@@ -1231,6 +1277,11 @@ bool ApplicationService::addOneInstance(const QString &instanceId,
                                         const QString &launcher,
                                         const QString &launchType) noexcept
 {
+    // instances can't be registered beneath a virtual node
+    if (!ensureMaterialized()) {
+        return false;
+    }
+
     auto *service = new (std::nothrow) InstanceService{instanceId, application, systemdUnitPath, launcher, launchType};
     if (service == nullptr) {
         qCritical() << "couldn't new InstanceService.";
@@ -1249,7 +1300,9 @@ bool ApplicationService::addOneInstance(const QString &instanceId,
         return false;
     }
 
-    m_Instances.insert(QDBusObjectPath{objectPath}, QSharedPointer<InstanceService>{service});
+    QSharedPointer<InstanceService> instance{service};
+    m_Instances.insert(QDBusObjectPath{objectPath}, instance);
+    InstanceIndex::instance().insert(id(), QDBusObjectPath{objectPath}, instance);
     service->moveToThread(this->thread());
     adaptor->moveToThread(this->thread());
 
@@ -1274,14 +1327,16 @@ void ApplicationService::removeOneInstance(const QDBusObjectPath &instance) noex
         emit InterfacesRemoved(instance, interfaces);
         sendObjectManagerSignal(m_applicationPath.path(), "InterfacesRemoved", instance, QVariant::fromValue(interfaces));
         unregisterObjectFromDBus(instance.path());
+        InstanceIndex::instance().remove(it.value()->systemdUnitPath().path());
         m_Instances.remove(instance);
     }
 }
 
 void ApplicationService::removeAllInstance() noexcept
 {
-    for (auto it = m_Instances.constBegin(); it != m_Instances.constEnd(); ++it) {
-        removeOneInstance(it.key());
+    const auto paths = m_Instances.keys();
+    for (const auto &path : paths) {
+        removeOneInstance(path);
     }
 }
 
@@ -1304,41 +1359,27 @@ void ApplicationService::handleUnitStarted(const QString &instanceId,
         lt = u"unknown"_s;
     }
 
+    // Result of the unit is recorded into InstanceIndex by ApplicationManager1Service
     if (!addOneInstance(instanceId, m_applicationPath.path(), systemdUnitPath, launcher, lt)) {
         qCCritical(DDEAM) << "failed to add instance" << systemdUnitPath << "to app" << id();
     }
-
-    auto watcher = new UnitResultWatcher(QDBusObjectPath{systemdUnitPath}, this);
-    connect(watcher, &UnitResultWatcher::resultReady, this, [this](const QDBusObjectPath &unitPath, const QString &result) {
-        qCDebug(DDEAM) << "onUnitResultReady: unitPath=" << unitPath.path() << "result=" << result;
-        m_unitResults.insert(unitPath.path(), result);
-    });
-    auto &bus = ApplicationManager1DBus::instance().globalDestBus();
-    auto connected = bus.connect(QString::fromUtf8(SystemdService),
-                                 systemdUnitPath,
-                                 QString::fromUtf16(SystemdPropInterfaceName),
-                                 u"PropertiesChanged"_s,
-                                 watcher,
-                                 SLOT(handlePropertyChanged(QString,QVariantMap,QStringList)));
-    qCDebug(DDEAM) << "UnitResultWatcher connect for" << systemdUnitPath << "result:" << connected;
 }
 
 void ApplicationService::handleUnitRemoved(const QString &systemdUnitPath, const QString &unitName) noexcept
 {
     using namespace Qt::StringLiterals;
 
-    const QDBusObjectPath unitPath{systemdUnitPath};
-
-    auto instanceIt =
-        std::find_if(m_Instances.cbegin(), m_Instances.cend(), [&unitPath](const QSharedPointer<InstanceService> &value) {
-            return value->property("SystemdUnitPath") == unitPath;
-        });
+    const auto *entry = InstanceIndex::instance().findByUnitPath(systemdUnitPath);
+    if (entry == nullptr || entry->orphaned || entry->appId != id()) {
+        return;
+    }
 
+    auto instanceIt = m_Instances.constFind(entry->objectPath);
     if (instanceIt == m_Instances.cend()) {
         return;
     }
 
-    auto result = m_unitResults.take(systemdUnitPath);
+    const auto result = entry->unitResult;
     qCDebug(DDEAM) << "removeInstance: unitPath=" << systemdUnitPath << "cached result=" << result;
 
     static const QSet<QString> launchFailedResults{
@@ -1351,26 +1392,9 @@ void ApplicationService::handleUnitRemoved(const QString &systemdUnitPath, const
                                              (*instanceIt)->launchType(),
                                              (*instanceIt)->instanceId());
     } else if (!result.isEmpty() && result != u"success"_s) {
-        QStringList logArgs{"--user", QStringLiteral("--unit=%1").arg(unitName),
-                            "-p", "warning", "-n", "6", "-o", "cat", "-o", "with-unit", "--no-pager"};
-        QProcess logProc;
-        logProc.start("journalctl", logArgs);
-        QString logInfo;
-        if (!logProc.waitForStarted(1000)) {
-            qCWarning(DDEAM) << "journalctl failed to start for unit:" << unitName;
-        } else if (!logProc.waitForFinished(3000)) {
-            qCWarning(DDEAM) << "journalctl timeout for unit:" << unitName;
-            logProc.kill();
-        } else {
-            logInfo = QString::fromUtf8(logProc.readAllStandardOutput());
-        }
-
-        EventReporter::instance().reportAppAbnormalExit(eventAppId(),
-                                             (*instanceIt)->launchType(),
-                                             unitName,
-                                             logInfo,
-                                             x_linglong(),
-                                             (*instanceIt)->instanceId());
+        // journal is read on a worker thread, the report is sent when it's done
+        AbnormalExitCollector::instance().collect(
+            {eventAppId(), (*instanceIt)->launchType(), unitName, (*instanceIt)->instanceId(), x_linglong()});
     }
 
     removeOneInstance(instanceIt.key());
@@ -1380,7 +1404,7 @@ void ApplicationService::detachAllInstance() noexcept
 {
     for (auto it = m_Instances.constBegin(); it != m_Instances.constEnd(); ++it) {
         const auto &instance = it.value();
-        orphanedInstances.append(instance);
+        InstanceIndex::instance().orphan(instance->systemdUnitPath().path());
         instance->setProperty("Orphaned", true);
     }
 
@@ -1415,17 +1439,21 @@ void ApplicationService::closeAllSplashes() noexcept
 
 QDBusObjectPath ApplicationService::findInstance(const QString &instanceId) const
 {
-    for (auto it = m_Instances.constKeyValueBegin(); it != m_Instances.constKeyValueEnd(); ++it) {
-        const auto &[path, ptr] = *it;
-        if (ptr->instanceId() == instanceId) {
-            return path;
-        }
+    const auto *entry = InstanceIndex::instance().findByInstanceId(instanceId);
+    if (entry == nullptr || entry->orphaned || entry->appId != id() || !m_Instances.contains(entry->objectPath)) {
+        return {};
     }
-    return {};
+
+    return entry->objectPath;
 }
 
 void ApplicationService::resetEntry(DesktopEntry *newEntry) noexcept
 {
+    // changes of entry are announced through PropertiesChanged
+    if (!ensureMaterialized()) {
+        qWarning() << "failed to materialize" << id() << ", property changes won't be announced.";
+    }
+
     m_entry.reset(newEntry);
     emit autostartChanged();
     emit noDisplayChanged();
@@ -1736,6 +1764,16 @@ QVariant ApplicationService::findEntryValue(const QString &group,
     Q_UNREACHABLE();
 }
 
+void ApplicationService::sendError(QDBusError::ErrorType type, const QString &message) const noexcept
+{
+    if (m_capturedError != nullptr) {
+        *m_capturedError = QDBusError{type, message};
+        return;
+    }
+
+    safe_sendErrorReply(type, message);
+}
+
 void ApplicationService::updateAfterLaunch(bool isLaunch) noexcept
 {
     if (!isLaunch) {
@@ -1763,6 +1801,7 @@ void ApplicationService::updateAfterLaunch(bool isLaunch) noexcept
 
         m_lastLaunch = timestamp;
         m_launchedTimes += 1;
+        std::ignore = ensureMaterialized();
         emit lastLaunchedTimeChanged();
         emit launchedTimesChanged();
     }
@@ -1770,6 +1809,10 @@ void ApplicationService::updateAfterLaunch(bool isLaunch) noexcept
 
 void ApplicationService::setAutostartSource(AutostartSource &&source) noexcept
 {
+    if (const auto *manager = parent(); manager != nullptr && !manager->isStartupPhase()) {
+        std::ignore = ensureMaterialized();
+    }
+
     m_autostartSource = std::move(source);
     emit autostartChanged();
 }
@@ -13,10 +13,12 @@
 #include "desktopentry.h"
 #include "global.h"
 #include <QDBusContext>
+#include <QDBusError>
 #include <QDBusObjectPath>
 #include <QDBusUnixFileDescriptor>
 #include <QFile>
 #include <QObject>
+#include <QScopeGuard>
 #include <QSet>
 #include <QSharedPointer>
 #include <QString>
@@ -160,6 +162,19 @@ public:
 
     [[nodiscard]] static std::optional<QStringList> splitExecArguments(QStringView str) noexcept;
     bool ensurePropertiesForwarder() noexcept;
+    bool ensureMaterialized() noexcept;
+    [[nodiscard]] bool isMaterialized() const noexcept { return m_materialized; }
+    // same as Launch, but reports the failure through error since it may be called outside of a D-Bus context
+    QDBusObjectPath launch(const QString &action, const QStringList &fields, const QVariantMap &options, QDBusError &error);
+    // runs call with the errors of property writes and desktop operations stored in error, for calls which
+    // aren't delivered by QtDBus and have no D-Bus context to reply through
+    template <typename Call>
+    decltype(auto) captureErrors(QDBusError &error, Call &&call) const
+    {
+        m_capturedError = &error;
+        const auto guard = qScopeGuard([this] { m_capturedError = nullptr; });
+        return std::forward<Call>(call)();
+    }
 
 public Q_SLOTS:
     // NOTE: 'realExec' only for internal implementation
@@ -219,11 +234,13 @@ private:
     QSharedPointer<DesktopEntry> m_entry{nullptr};
     QHash<QDBusObjectPath, QSharedPointer<InstanceService>> m_Instances;
     QHash<QString, QString> m_pendingLaunchTypes;
-    QHash<QString, QString> m_unitResults;
     QSet<QString> m_splashInstanceIds;
     bool m_propertiesForwarderInitialized{false};
+    bool m_materialized{false};
+    mutable QDBusError *m_capturedError{nullptr};
     QString m_eventAppId;
     void updateAfterLaunch(bool isLaunch) noexcept;
+    void sendError(QDBusError::ErrorType type, const QString &message = {}) const noexcept;
     static bool shouldBeShown(const std::unique_ptr<DesktopEntry> &entry, QStringView desktopId, const SessionOverrideConfig *sessionConfig = nullptr) noexcept;
     [[nodiscard]] bool autostartCheck() const noexcept;
     [[nodiscard]] bool autostartSourceFileExists() const noexcept;
@@ -41,3 +41,53 @@ void InstanceService::KillAll(int signal)
 
     safe_sendErrorReply(reply.errorName(), reply.errorMessage());
 }
+
+void InstanceIndex::insert(const QString &appId,
+                           const QDBusObjectPath &objectPath,
+                           const QSharedPointer<InstanceService> &instance) noexcept
+{
+    const auto &unitPath = instance->systemdUnitPath().path();
+    remove(unitPath);
+
+    m_instanceIds.insert(instance->instanceId(), unitPath);
+    m_units.insert(unitPath, Entry{appId, objectPath, instance, {}, false});
+}
+
+void InstanceIndex::remove(const QString &systemdUnitPath) noexcept
+{
+    auto it = m_units.find(systemdUnitPath);
+    if (it == m_units.end()) {
+        return;
+    }
+
+    if (auto id = m_instanceIds.constFind(it->instance->instanceId()); id != m_instanceIds.cend() && id.value() == systemdUnitPath) {
+        m_instanceIds.erase(id);
+    }
+    m_units.erase(it);
+}
+
+void InstanceIndex::orphan(const QString &systemdUnitPath) noexcept
+{
+    if (auto it = m_units.find(systemdUnitPath); it != m_units.end()) {
+        it->orphaned = true;
+    }
+}
+
+void InstanceIndex::setUnitResult(const QString &systemdUnitPath, const QString &result) noexcept
+{
+    if (auto it = m_units.find(systemdUnitPath); it != m_units.end()) {
+        it->unitResult = result;
+    }
+}
+
+const InstanceIndex::Entry *InstanceIndex::findByUnitPath(const QString &systemdUnitPath) const noexcept
+{
+    auto it = m_units.constFind(systemdUnitPath);
+    return it == m_units.cend() ? nullptr : &it.value();
+}
+
+const InstanceIndex::Entry *InstanceIndex::findByInstanceId(const QString &instanceId) const noexcept
+{
+    auto id = m_instanceIds.constFind(instanceId);
+    return id == m_instanceIds.cend() ? nullptr : findByUnitPath(id.value());
+}
@@ -8,6 +8,8 @@
 #include <QObject>
 #include <QDBusObjectPath>
 #include <QDBusContext>
+#include <QHash>
+#include <QSharedPointer>
 
 class InstanceService : public QObject, protected QDBusContext
 {
@@ -27,6 +29,7 @@ public:
 
     [[nodiscard]] const QString &instanceId() const noexcept { return m_instanceId; }
     [[nodiscard]] const QString &launchType() const noexcept { return m_launchType; }
+    [[nodiscard]] const QDBusObjectPath &systemdUnitPath() const noexcept { return m_SystemdUnitPath; }
 
 public Q_SLOTS:
     void KillAll(int signal);
@@ -45,6 +48,41 @@ private:
     QDBusObjectPath m_SystemdUnitPath;
 };
 
-static inline QList<QSharedPointer<InstanceService>> orphanedInstances{};
+// Instances of all applications by systemd unit path and by instance id.
+// Orphaned instances, whose application has been updated or removed, are kept alive here until their unit is removed.
+class InstanceIndex
+{
+public:
+    struct Entry
+    {
+        QString appId;
+        QDBusObjectPath objectPath;
+        QSharedPointer<InstanceService> instance;
+        QString unitResult;  // latest failed Result of the unit
+        bool orphaned{false};
+    };
+
+    static InstanceIndex &instance() noexcept
+    {
+        static InstanceIndex index;
+        return index;
+    }
+
+    void insert(const QString &appId, const QDBusObjectPath &objectPath, const QSharedPointer<InstanceService> &instance) noexcept;
+    void remove(const QString &systemdUnitPath) noexcept;
+    void orphan(const QString &systemdUnitPath) noexcept;
+    void setUnitResult(const QString &systemdUnitPath, const QString &result) noexcept;
+
+    // returned pointers are invalidated by any modification of the index
+    [[nodiscard]] const Entry *findByUnitPath(const QString &systemdUnitPath) const noexcept;
+    [[nodiscard]] const Entry *findByInstanceId(const QString &instanceId) const noexcept;
+    [[nodiscard]] qsizetype size() const noexcept { return m_units.size(); }
+
+private:
+    InstanceIndex() = default;
+
+    QHash<QString, Entry> m_units;
+    QHash<QString, QString> m_instanceIds;  // instance id -> systemd unit path
+};
 
 #endif
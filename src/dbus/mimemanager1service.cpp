@@ -6,12 +6,14 @@
 #include "dbus/mimemanager1adaptor.h"
 #include "applicationmanager1service.h"
 #include "applicationservice.h"  // IWYU pragma: keep
+#include "applicationobjectdispatcher.h"
 #include "constant.h"
 
+using namespace Qt::StringLiterals;
+
 MimeManager1Service::MimeManager1Service(ApplicationManager1Service *parent)
     : QObject(parent)
 {
-    using namespace Qt::StringLiterals;
     auto *adaptor = new (std::nothrow) MimeManager1Adaptor{this};
     if (adaptor == nullptr || !registerObjectToDBus(this,
                                                     fromStaticRaw(DDEApplicationManager1MimeManager1ObjectPath),
@@ -45,27 +47,24 @@ ObjectMap MimeManager1Service::listApplications(const QString &mimeType) const n
         type = mimeType;
     }
 
-    QStringList appIds;
-
-    for (auto it = m_infos.begin(); it != m_infos.end(); ++it) {
-        const auto &info = it->cacheInfo();
-        if (!info) {
-            continue;
-        }
-        auto apps = info->queryApps(type);
-        appIds.append(std::move(apps));
-    }
-    appIds.removeDuplicates();
+    const auto appIds = m_table.cachedApplications(type);
     qInfo() << "query" << mimeType << "find:" << appIds;
     const auto &apps = dynamic_cast<ApplicationManager1Service *>(parent())->findApplicationsByIds(appIds);
-    return dumpDBusObject(apps);
+    return ApplicationObjectDispatcher::dumpApplications(apps.values());
 }
 
 QString MimeManager1Service::queryDefaultApplication(const QString &content, QDBusObjectPath &application) const noexcept
+{
+    QString matchedType;
+    return resolveDefaultApplication(content, matchedType, application);
+}
+
+QString MimeManager1Service::resolveDefaultApplication(const QString &content,
+                                                       QString &matchedType,
+                                                       QDBusObjectPath &application) const noexcept
 {
     QMimeType mime;
     QFileInfo info{content};
-    application = QDBusObjectPath{"/"};
 
     if (info.isAbsolute() and info.exists()) {
         mime = m_database.mimeTypeForFile(content);
@@ -80,34 +79,55 @@ QString MimeManager1Service::queryDefaultApplication(const QString &content, QDB
         type = content;
     }
 
-    QString defaultAppId;
-    for (auto it1 = m_infos.begin(); it1 != m_infos.end(); ++it1) {
-        const auto &list = it1->appsList();
-        for (auto it2 = list.begin(); it2 != list.end(); ++it2) {
-            if (auto app = it2->queryDefaultApp(type); !app.isEmpty()) {
-                defaultAppId = app;
-                break;
-            }
+    matchedType = findDefaultApplication(type, application);
+    return type;
+}
+
+PropMap MimeManager1Service::queryDefaultApplications(const QStringList &contents) noexcept
+{
+    const auto fileTypes = m_sniffer.mimeTypesForFiles(contents);
+
+    PropMap ret;
+    for (qsizetype i = 0; i < contents.size(); ++i) {
+        const auto &content = contents.at(i);
+        auto type = fileTypes.at(i);
+        if (type.isEmpty()) {
+            type = m_database.mimeTypeForName(content).name();
         }
-        if (!defaultAppId.isEmpty()) {
-            break;
+        if (type.isEmpty()) {
+            type = content;
         }
+
+        QDBusObjectPath application;
+        auto matchedType = findDefaultApplication(type, application);
+        ret.insert(content,
+                   QStringMap{{u"MimeType"_s, std::move(type)},
+                              {u"MatchedType"_s, std::move(matchedType)},
+                              {u"Application"_s, application.path()}});
     }
 
-    if (defaultAppId.isEmpty()) {
-        qInfo() << "file's mimeType:" << mime.name() << "but can't find a default application for this type.";
-        return type;
+    return ret;
+}
+
+QString MimeManager1Service::findDefaultApplication(const QString &type, QDBusObjectPath &application) const noexcept
+{
+    application = QDBusObjectPath{"/"};
+
+    const auto resolved = m_table.resolveDefault(type);
+    if (resolved.appId.isEmpty()) {
+        qInfo() << "can't find a default application for mimeType:" << type;
+        return {};
     }
 
-    const auto &apps = dynamic_cast<ApplicationManager1Service *>(parent())->findApplicationsByIds({defaultAppId});
+    const auto &apps = dynamic_cast<ApplicationManager1Service *>(parent())->findApplicationsByIds({resolved.appId});
     if (apps.isEmpty()) {
-        qWarning() << "default application has been found:" << defaultAppId
+        qWarning() << "default application has been found:" << resolved.appId
                    << " but we can't find corresponding application in ApplicationManagerService.";
     } else {
         application = apps.constBegin().key();
     }
 
-    return type;
+    return resolved.matchedType;
 }
 
 void MimeManager1Service::setDefaultApplication(const QStringMap &defaultApps) noexcept
@@ -132,12 +152,14 @@ void MimeManager1Service::setDefaultApplication(const QStringMap &defaultApps) n
     for (auto it = defaultApps.constKeyValueBegin(); it != defaultApps.constKeyValueEnd(); ++it) {
         userConfig->setDefaultApplication(it->first, it->second);
     }
+    updateResolution(*userConfig);
 
     if (!userConfig->writeToFile()) {
         safe_sendErrorReply(QDBusError::Failed, "set default app failed, these config will be reset after re-login.");
         m_internalWriteInProgress = false;
         return;
     }
+    userConfig->updateStamp();
 }
 
 void MimeManager1Service::unsetDefaultApplication(const QStringList &mimeTypes) noexcept
@@ -155,12 +177,14 @@ void MimeManager1Service::unsetDefaultApplication(const QStringList &mimeTypes)
     for (const auto &mime : mimeTypes) {
         userConfig->unsetDefaultApplication(mime);
     }
+    updateResolution(*userConfig);
 
     if (!userConfig->writeToFile()) {
         safe_sendErrorReply(QDBusError::Failed, "unset default app failed, these config will be reset after re-login.");
         m_internalWriteInProgress = false;
         return;
     }
+    userConfig->updateStamp();
 }
 
 void MimeManager1Service::appendMimeInfo(MimeInfo &&info)
@@ -171,6 +195,83 @@ void MimeManager1Service::appendMimeInfo(MimeInfo &&info)
 void MimeManager1Service::reset() noexcept
 {
     m_infos.clear();
+    m_table.clear();
+    m_sniffer.clear();
+}
+
+bool MimeManager1Service::refreshMimeInfos(const QStringList &dirs) noexcept
+{
+    // shared-mime-info may be updated together with applications
+    m_sniffer.clear();
+
+    std::vector<MimeInfo> refreshed;
+    refreshed.reserve(static_cast<size_t>(dirs.size()));
+    bool needRebuild{static_cast<qsizetype>(m_infos.size()) != dirs.size()};
+    bool changed{false};
+
+    for (const auto &dir : dirs) {
+        auto info = std::find_if(m_infos.begin(), m_infos.end(), [&dir](const MimeInfo &mimeInfo) { return mimeInfo.directory() == dir; });
+        if (info == m_infos.end() || info->isLayoutChanged()) {
+            // a list or cache appeared or disappeared, load the whole directory again
+            qCInfo(DDEAMMime) << "reload mime directory" << dir;
+            if (auto newInfo = MimeInfo::createMimeInfo(dir); newInfo) {
+                refreshed.emplace_back(std::move(newInfo).value());
+            }
+            needRebuild = true;
+            continue;
+        }
+
+        for (auto &apps : info->appsList()) {
+            if (apps.isModified()) {
+                qCInfo(DDEAMMime) << "reload modified" << apps.fileInfo().absoluteFilePath();
+                apps.reload();
+                changed = true;
+                if (!needRebuild) {
+                    m_table.updateFile(apps);
+                }
+            }
+        }
+
+        if (auto &cache = info->cacheInfo(); cache && cache->isModified()) {
+            qCInfo(DDEAMMime) << "reload modified" << cache->fileInfo().absoluteFilePath();
+            cache->reload();
+            changed = true;
+            if (!needRebuild) {
+                m_table.updateFile(*cache);
+            }
+        }
+
+        refreshed.emplace_back(std::move(*info));
+    }
+
+    m_infos = std::move(refreshed);
+    if (needRebuild) {
+        rebuildResolutionTable();
+
+        // sidecars of caches which disappeared would never be used again
+        QStringList caches;
+        for (const auto &info : m_infos) {
+            if (const auto &cache = info.cacheInfo(); cache) {
+                caches.append(cache->fileInfo().absoluteFilePath());
+            }
+        }
+        MimeCacheIndex::prune(caches);
+    }
+
+    return changed || needRebuild;
+}
+
+void MimeManager1Service::rebuildResolutionTable() noexcept
+{
+    m_table.rebuild(m_infos);
+}
+
+void MimeManager1Service::updateResolution(const MimeFileBase &file) noexcept
+{
+    if (!m_table.updateFile(file)) {
+        qWarning() << file.fileInfo().absoluteFilePath() << "isn't a source of mime resolution table, rebuild it.";
+        rebuildResolutionTable();
+    }
 }
 
 void MimeManager1Service::updateMimeCache(QString dir) noexcept
@@ -181,6 +282,21 @@ void MimeManager1Service::updateMimeCache(QString dir) noexcept
     auto exitCode = process.exitCode();
     if (exitCode != 0) {
         qWarning() << "Launch Application Failed";
+        return;
+    }
+
+    auto info = std::find_if(m_infos.begin(), m_infos.end(), [&dir](const MimeInfo &mimeInfo) { return mimeInfo.directory() == dir; });
+    if (info == m_infos.end()) {
+        return;
+    }
+
+    if (auto &cache = info->cacheInfo(); cache) {
+        cache->reload();
+        updateResolution(*cache);
+    } else if (auto newInfo = MimeInfo::createMimeInfo(dir); newInfo && newInfo->cacheInfo()) {
+        // the cache is created by update-desktop-database just now
+        cache = std::move(newInfo->cacheInfo());
+        rebuildResolutionTable();
     }
 }
 
@@ -196,6 +312,7 @@ void MimeManager1Service::onMimeAppsFileChanged(const QString &path)
         return;
     }
 
+    m_changedMimeAppsFiles.insert(path);
     m_mimeAppsDebounceTimer.start();
 }
 
@@ -206,6 +323,26 @@ void MimeManager1Service::handleMimeAppsFileDebounced()
         return;
     }
 
+    const auto changedFiles = std::exchange(m_changedMimeAppsFiles, {});
+    bool reloaded{false};
+    for (auto &info : m_infos) {
+        for (auto &apps : info.appsList()) {
+            if (!changedFiles.contains(apps.fileInfo().absoluteFilePath())) {
+                continue;
+            }
+
+            qInfo() << "Reloading" << apps.fileInfo().absoluteFilePath() << "due to external configuration change.";
+            apps.reload();
+            updateResolution(apps);
+            reloaded = true;
+        }
+    }
+
+    if (reloaded) {
+        emit MimeInfoReloaded();
+        return;
+    }
+
     qInfo() << "Reloading MIME info due to external configuration change.";
     parentService->reloadMimeInfos();
 }
@@ -9,10 +9,13 @@
 #include <QDBusContext>
 #include <QDBusObjectPath>
 #include <QFileSystemWatcher>
+#include <QSet>
 #include <QTimer>
 
 #include "global.h"
 #include "applicationmimeinfo.h"
+#include "mimeresolutiontable.h"
+#include "mimetypesniffer.h"
 
 class ApplicationManager1Service;
 
@@ -28,10 +31,21 @@ public:
     [[nodiscard]] auto &infos() noexcept { return m_infos; }
     void reset() noexcept;
     void updateMimeCache(QString dir) noexcept;
+    // re-parses only the files whose mtime or size changed, a directory is loaded again
+    // only if one of its files is created or removed. returns true if anything is reloaded.
+    bool refreshMimeInfos(const QStringList &dirs) noexcept;
+    // call after all mime infos are appended
+    void rebuildResolutionTable() noexcept;
+    // call after the content of one mimeapps.list or mimeinfo.cache is changed in memory
+    void updateResolution(const MimeFileBase &file) noexcept;
+    [[nodiscard]] const MimeResolutionTable &resolutionTable() const noexcept { return m_table; }
 
 public Q_SLOTS:
     [[nodiscard]] ObjectMap listApplications(const QString &mimeType) const noexcept;
     [[nodiscard]] QString queryDefaultApplication(const QString &content, QDBusObjectPath &application) const noexcept;
+    [[nodiscard]] QString
+    resolveDefaultApplication(const QString &content, QString &matchedType, QDBusObjectPath &application) const noexcept;
+    [[nodiscard]] PropMap queryDefaultApplications(const QStringList &contents) noexcept;
     void setDefaultApplication(const QStringMap &defaultApps) noexcept;
     void unsetDefaultApplication(const QStringList &mimeTypes) noexcept;
 
@@ -43,8 +57,14 @@ private Q_SLOTS:
     void handleMimeAppsFileDebounced();
 
 private:
+    // returns the matched type, application is "/" if nothing is found
+    QString findDefaultApplication(const QString &type, QDBusObjectPath &application) const noexcept;
+
     QMimeDatabase m_database;
     std::vector<MimeInfo> m_infos;
+    MimeResolutionTable m_table;
+    MimeTypeSniffer m_sniffer;
+    QSet<QString> m_changedMimeAppsFiles;
     QFileSystemWatcher m_mimeAppsWatcher;
     // 内部写入标志，用于避免触发外部修改的处理
     bool m_internalWriteInProgress{false};
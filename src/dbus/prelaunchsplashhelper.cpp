@@ -8,6 +8,7 @@
 #include <QLoggingCategory>
 #include <QMessageLogger>
 #include <QPainter>
+#include <QStringBuilder>
 #include <QtWaylandClient/private/qwaylanddisplay_p.h>
 #include <QtWaylandClient/private/qwaylandintegration_p.h>
 #include <QtWaylandClient/private/qwaylandshmbackingstore_p.h>
@@ -20,6 +21,14 @@ Q_LOGGING_CATEGORY(amPrelaunchSplash, "dde.am.prelaunch.splash")
 PrelaunchSplashHelper::PrelaunchSplashHelper()
     : QWaylandClientExtensionTemplate<PrelaunchSplashHelper>(1)
 {
+    // QIcon and shm buffers belong to the GUI thread, so prewarming is spread over idle iterations instead.
+    m_prewarmTimer.setInterval(0);
+    connect(&m_prewarmTimer, &QTimer::timeout, this, &PrelaunchSplashHelper::prewarmNext);
+    connect(this, &QWaylandClientExtension::activeChanged, this, [this]() {
+        if (isActive() && !m_prewarmQueue.isEmpty()) {
+            m_prewarmTimer.start();
+        }
+    });
 }
 
 PrelaunchSplashHelper::~PrelaunchSplashHelper()
@@ -34,7 +43,8 @@ static const struct wl_buffer_listener kBufferListener = {
     PrelaunchSplashHelper::bufferRelease,
 };
 
-wl_buffer *PrelaunchSplashHelper::createBufferWithPainter(const QSize &iconSize, qreal devicePixelRatio, const QIcon &icon)
+std::unique_ptr<QtWaylandClient::QWaylandShmBuffer>
+PrelaunchSplashHelper::createBufferWithPainter(const QSize &iconSize, qreal devicePixelRatio, const QIcon &icon)
 {
     auto *waylandIntegration = integration();
     auto *waylandDisplay = waylandIntegration ? waylandIntegration->display() : nullptr;
@@ -61,14 +71,11 @@ wl_buffer *PrelaunchSplashHelper::createBufferWithPainter(const QSize &iconSize,
     painter.fillRect(buffer->image()->rect(), Qt::transparent);
     icon.paint(&painter, targetRect);
 
-    auto *wlBuf = buffer->buffer();
-    wl_buffer_add_listener(wlBuf, &kBufferListener, this);
-
-    m_iconBuffers.emplace_back(std::move(buffer));
-    return wlBuf;
+    wl_buffer_add_listener(buffer->buffer(), &kBufferListener, this);
+    return buffer;
 }
 
-wl_buffer *PrelaunchSplashHelper::buildIconBuffer(const QIcon &icon)
+std::unique_ptr<QtWaylandClient::QWaylandShmBuffer> PrelaunchSplashHelper::buildIconBuffer(const QIcon &icon)
 {
     if (icon.isNull()) {
         return nullptr;
@@ -99,21 +106,72 @@ wl_buffer *PrelaunchSplashHelper::buildIconBuffer(const QIcon &icon)
     return createBufferWithPainter(iconSize, dpr, icon);
 }
 
-void PrelaunchSplashHelper::show(const QString &appId, const QString &instanceId, const QString &iconName)
+wl_buffer *PrelaunchSplashHelper::iconBuffer(const QString &iconName)
 {
-    if (!isActive()) {
-        qCWarning(amPrelaunchSplash, "Skip prelaunch splash (extension inactive): %s", qPrintable(appId));
-        return;
+    if (const auto theme = QIcon::themeName(); theme != m_iconTheme) {
+        invalidateIconCache();
+        m_iconTheme = theme;
     }
 
-    QIcon icon;
-    if (iconName.isEmpty()) {
-        qCWarning(amPrelaunchSplash, "%s", "Icon name empty; splash will be sent without icon buffer");
-    } else {
-        icon = QIcon::fromTheme(iconName);
+    const qreal dpr = qApp ? qApp->devicePixelRatio() : 1.0;
+    const auto key = m_iconTheme % u'\n' % iconName % u'\n' % QString::number(dpr);
+
+    auto cached = m_iconCache.lookup(key);
+    if (!cached) {
+        const auto icon = QIcon::fromTheme(iconName);
         if (icon.isNull()) {
             qCWarning(amPrelaunchSplash, "Icon not found in theme: %s", qPrintable(iconName));
         }
+
+        cached = m_iconCache.insert(key, buildIconBuffer(icon));
+    }
+
+    return *cached ? (*cached)->buffer() : nullptr;
+}
+
+void PrelaunchSplashHelper::invalidateIconCache()
+{
+    m_iconCache.clear();
+}
+
+void PrelaunchSplashHelper::prewarm(const QStringList &iconNames)
+{
+    m_prewarmQueue.clear();
+    for (const auto &iconName : iconNames) {
+        if (m_prewarmQueue.size() >= kPrewarmLimit) {
+            break;
+        }
+
+        if (!iconName.isEmpty() && !m_prewarmQueue.contains(iconName)) {
+            m_prewarmQueue.append(iconName);
+        }
+    }
+
+    if (isActive() && !m_prewarmQueue.isEmpty()) {
+        m_prewarmTimer.start();
+    }
+}
+
+void PrelaunchSplashHelper::prewarmNext()
+{
+    if (!isActive() || m_prewarmQueue.isEmpty()) {
+        m_prewarmTimer.stop();
+        return;
+    }
+
+    const auto iconName = m_prewarmQueue.takeFirst();
+    iconBuffer(iconName);
+    if (m_prewarmQueue.isEmpty()) {
+        m_prewarmTimer.stop();
+        qCInfo(amPrelaunchSplash, "Prewarmed %lld splash icons", static_cast<long long>(m_iconCache.size()));
+    }
+}
+
+void PrelaunchSplashHelper::show(const QString &appId, const QString &instanceId, const QString &iconName)
+{
+    if (!isActive()) {
+        qCWarning(amPrelaunchSplash, "Skip prelaunch splash (extension inactive): %s", qPrintable(appId));
+        return;
     }
 
     // If this instance already has a splash, skip creating a new one.
@@ -122,8 +180,17 @@ void PrelaunchSplashHelper::show(const QString &appId, const QString &instanceId
         return;
     }
 
-    // Keep previously sent buffers alive; compositor releases them asynchronously.
-    wl_buffer *buffer = buildIconBuffer(icon);
+    wl_buffer *buffer{nullptr};
+    if (iconName.isEmpty()) {
+        qCWarning(amPrelaunchSplash, "%s", "Icon name empty; splash will be sent without icon buffer");
+    } else {
+        buffer = iconBuffer(iconName);
+    }
+
+    // Cached buffers stay alive while the compositor uses them, it sends a single release once it is done.
+    if (buffer) {
+        m_iconCache.attach(buffer);
+    }
 
     auto *splash = new QtWayland::treeland_prelaunch_splash_v2();
     splash->init(create_splash(appId, instanceId, QStringLiteral("dde-application-manager"), buffer));
@@ -155,12 +222,5 @@ void PrelaunchSplashHelper::closeSplash(const QString &instanceId)
 
 void PrelaunchSplashHelper::handleBufferRelease(wl_buffer *buffer)
 {
-    auto it = std::find_if(m_iconBuffers.begin(), m_iconBuffers.end(), [buffer](const auto &holder) {
-        return holder->buffer() == buffer;
-    });
-
-    if (it != m_iconBuffers.end()) {
-        m_iconBuffers.erase(it);
-    }
+    m_iconCache.release(buffer);
 }
-
@@ -9,10 +9,12 @@
 #include <QIcon>
 #include <QLoggingCategory>
 #include <QObject>
+#include <QStringList>
+#include <QTimer>
 #include <QtWaylandClient/QWaylandClientExtension>
 #include <memory>
-#include <vector>
 
+#include "iconbuffercache.h"
 #include "qwayland-treeland-prelaunch-splash-v2.h"
 
 // Wayland C types
@@ -33,6 +35,10 @@ Q_DECLARE_LOGGING_CATEGORY(amPrelaunchSplash)
  * Destroying the object dismisses the corresponding splash. Objects are
  * tracked per instance_id so non-singleton apps can have multiple splashes.
  *
+ * Rendered icon buffers are kept in a small LRU cache keyed by icon theme,
+ * icon name and device pixel ratio, so a warm launch attaches an existing
+ * buffer instead of rasterizing the icon.
+ *
  * Not thread-safe; use from the Qt GUI thread.
  */
 class PrelaunchSplashHelper
@@ -55,6 +61,19 @@ public:
      * Destroys the splash object returned by create_splash.
      */
     void closeSplash(const QString &instanceId);
+
+    /**
+     * Render icons of the most launched applications ahead of time.
+     * At most kPrewarmLimit icons are taken, one is rendered per event loop iteration.
+     */
+    void prewarm(const QStringList &iconNames);
+
+    /**
+     * Drop all cached icon buffers, e.g. after icon files have been changed.
+     * Buffers still held by the compositor are freed once they're released.
+     */
+    void invalidateIconCache();
+
     /**
      * @brief Wayland wl_buffer_listener callback for buffer release.
      *
@@ -63,12 +82,21 @@ public:
      */
     static void bufferRelease(void *data, wl_buffer *buffer);
 
+    static constexpr qsizetype kIconCacheSize = 32;
+    static constexpr qsizetype kPrewarmLimit = 16;
+
 private:
-    wl_buffer *buildIconBuffer(const QIcon &icon);
-    wl_buffer *createBufferWithPainter(const QSize &iconSize, qreal devicePixelRatio, const QIcon &icon);
+    wl_buffer *iconBuffer(const QString &iconName);
+    std::unique_ptr<QtWaylandClient::QWaylandShmBuffer> buildIconBuffer(const QIcon &icon);
+    std::unique_ptr<QtWaylandClient::QWaylandShmBuffer>
+    createBufferWithPainter(const QSize &iconSize, qreal devicePixelRatio, const QIcon &icon);
+    void prewarmNext();
     void handleBufferRelease(wl_buffer *buffer);
 
-    std::vector<std::unique_ptr<QtWaylandClient::QWaylandShmBuffer>> m_iconBuffers;  // keep alive until compositor releases
+    IconBufferCache<QtWaylandClient::QWaylandShmBuffer> m_iconCache{kIconCacheSize};
+    QString m_iconTheme;
+    QStringList m_prewarmQueue;
+    QTimer m_prewarmTimer;
 
     // Active splash objects keyed by instance_id
     QHash<QString, QtWayland::treeland_prelaunch_splash_v2 *> m_splashObjects;
@@ -36,6 +36,7 @@ struct DesktopFile
     [[nodiscard]] bool hasStandardizedApplicationFileName() const noexcept;
     [[nodiscard]] bool modified(qint64 time) const noexcept;
     [[nodiscard]] qint64 createTime() const noexcept { return m_ctime; }
+    [[nodiscard]] qint64 modifiedTime() const noexcept { return m_mtime; }
 
     friend bool operator==(const DesktopFile &lhs, const DesktopFile &rhs);
     friend bool operator!=(const DesktopFile &lhs, const DesktopFile &rhs);
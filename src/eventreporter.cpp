@@ -6,6 +6,7 @@
 #include "config.h"
 #include "constant.h"
 #include "global.h"
+#include "packageindex.h"
 
 #ifdef HAVE_DDE_API_EVENTLOGGER
 #include <dde-api/eventlogger.hpp>
@@ -95,7 +96,18 @@ EventReporter::CacheEntry EventReporter::queryAppPackageInfo(const QString &appI
         } else {
             qCWarning(amEventReporter) << "ll-cli query failed for" << appId << "exitCode:" << proc.exitCode();
         }
+    } else if (const auto &index = PackageIndex::instance(); index.isReady()) {
+        auto package = index.findByDesktopId(appId);
+        if (!package) {
+            package = index.findByPackage(appId);
+        }
+
+        if (package) {
+            info.version = package->version;
+            info.pakType = "deb";
+        }
     } else {
+        // package index is still being built, ask dpkg directly
         QProcess proc;
         proc.start("dpkg-query", {"-W", "-f=${Version}", appId});
         if (!proc.waitForStarted(1000)) {
@@ -18,6 +18,8 @@ public:
     void reportAppLaunchFailed(const QString &appName, const QString &errors, bool isLinglong, const QString &launchType = {}, const QString &uniqueID = {});
     void reportAppAbnormalExit(const QString &appName, const QString &launchType, const QString &exec, const QString &logInfo, bool isLinglong, const QString &uniqueID = {});
 
+    bool shouldSkip(const QString &appId) const;
+
 private:
     EventReporter() = default;
 
@@ -27,7 +29,6 @@ private:
         qint64 timestamp = 0;
     };
 
-    bool shouldSkip(const QString &appId) const;
     CacheEntry queryAppPackageInfo(const QString &appId, bool isLinglong);
 
     QStringList m_skipEventAppIds;
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "executableidentifier.h"
+#include "global.h"
+#include <QDir>
+#include <QFile>
+#include <QStringBuilder>
+#include <climits>
+#include <cstdio>
+#include <unistd.h>
+
+namespace {
+// interpreters keep the script in the second argument
+constexpr qsizetype MaxCommandLineProgramIndex = 2;
+}  // namespace
+
+QString ExecutableIdentifier::readExecutable(pid_t pid) noexcept
+{
+    char link[32]{};
+    std::snprintf(link, sizeof(link), "/proc/%d/exe", pid);
+
+    char target[PATH_MAX]{};
+    auto len = ::readlink(link, target, sizeof(target) - 1);
+    if (len <= 0) {
+        return {};
+    }
+
+    auto path = QFile::decodeName(QByteArray::fromRawData(target, len));
+    // the binary has been replaced, e.g. by an upgrade
+    constexpr QStringView deletedSuffix{u" (deleted)"};
+    if (path.endsWith(deletedSuffix)) {
+        path.chop(deletedSuffix.size());
+    }
+
+    return path;
+}
+
+QStringList ExecutableIdentifier::readCommandLine(pid_t pid) noexcept
+{
+    QFile file{u"/proc/" % QString::number(pid) % u"/cmdline"};
+    if (!file.open(QFile::ExistingOnly | QFile::ReadOnly)) {
+        return {};
+    }
+
+    QStringList args;
+    const auto content = file.readAll();
+    for (const auto &arg : content.split('\0')) {
+        if (args.size() == MaxCommandLineProgramIndex) {
+            break;
+        }
+        args.append(QFile::decodeName(arg));
+    }
+
+    return args;
+}
+
+IdentifyRet ExecutableIdentifier::identifyPid(pid_t pid) const noexcept
+{
+    if (const auto exe = readExecutable(pid); !exe.isEmpty()) {
+        if (auto apps = m_index.findByExecutable(exe); !apps.isEmpty()) {
+            const auto confidence = apps.size() == 1 ? IdentifyConfidence::Medium : IdentifyConfidence::Low;
+            return {std::move(apps.first()), {}, confidence};
+        }
+    }
+
+    // a process can rewrite its command line, the result is only a hint
+    const auto args = readCommandLine(pid);
+    for (const auto &arg : args) {
+        if (!QDir::isAbsolutePath(arg)) {
+            continue;
+        }
+
+        if (auto apps = m_index.findByExecutable(arg); !apps.isEmpty()) {
+            return {std::move(apps.first()), {}, IdentifyConfidence::Low};
+        }
+    }
+
+    return {};
+}
+
+IdentifyRet ExecutableIdentifier::Identify(const QDBusUnixFileDescriptor &pidfd)
+{
+    auto pid = getPidFromPidFd(pidfd);
+    if (pid == 0) {
+        qWarning() << "Failed to extract PID from pidfd";
+        return {};
+    }
+
+    auto ret = identifyPid(static_cast<pid_t>(pid));
+    if (ret.ApplicationId.isEmpty()) {
+        return {};
+    }
+
+    // same as CGroupsIdentifier, the pid may have been reused while reading /proc
+    if (pidfd_send_signal(pidfd.fileDescriptor(), 0, nullptr, 0) != 0) {
+        const int errorCode = errno;
+        qWarning() << "pidfd is no longer valid (process may have exited), errno:" << errorCode;
+        return {};
+    }
+
+    return ret;
+}
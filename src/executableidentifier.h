@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef EXECUTABLEIDENTIFIER_H
+#define EXECUTABLEIDENTIFIER_H
+
+#include "applicationlookupindex.h"
+#include "identifier.h"
+#include <sys/types.h>
+
+// Identifies processes which don't run in an application unit, e.g. started from a terminal,
+// by looking up /proc/<pid>/exe and the program in /proc/<pid>/cmdline in the executable index.
+// Identify is safe to be called from several threads as long as the index isn't modified meanwhile.
+class ExecutableIdentifier : public Identifier
+{
+public:
+    explicit ExecutableIdentifier(const ApplicationLookupIndex &index) noexcept
+        : m_index(index)
+    {
+    }
+
+    IdentifyRet Identify(const QDBusUnixFileDescriptor &pidfd) override;
+    [[nodiscard]] IdentifyRet identifyPid(pid_t pid) const noexcept;
+
+private:
+    const ApplicationLookupIndex &m_index;
+
+    [[nodiscard]] static QString readExecutable(pid_t pid) noexcept;
+    [[nodiscard]] static QStringList readCommandLine(pid_t pid) noexcept;
+};
+
+#endif
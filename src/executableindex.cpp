@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "executableindex.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QLoggingCategory>
+#include <QStandardPaths>
+#include <algorithm>
+#include <utility>
+
+Q_LOGGING_CATEGORY(amExecutableIndex, "dde.am.executable.index")
+
+namespace {
+// package upgrades change a directory many times in a row
+constexpr int ChangeDelayMs = 200;
+}  // namespace
+
+ExecutableIndex &ExecutableIndex::instance()
+{
+    static ExecutableIndex index;
+    return index;
+}
+
+ExecutableIndex::ExecutableIndex()
+{
+    m_changeTimer.setInterval(ChangeDelayMs);
+    m_changeTimer.setSingleShot(true);
+    connect(&m_changeTimer, &QTimer::timeout, this, &ExecutableIndex::applyChanges);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ExecutableIndex::onDirectoryChanged);
+}
+
+QSet<QString> ExecutableIndex::listExecutables(const QString &path) noexcept
+{
+    QSet<QString> ret;
+    QDirIterator it{path, QDir::Files | QDir::Executable | QDir::NoDotAndDotDot};
+    while (it.hasNext()) {
+        it.next();
+        ret.insert(it.fileName());
+    }
+    return ret;
+}
+
+void ExecutableIndex::setSearchPaths(const QStringList &searchPaths) noexcept
+{
+    QStringList dirs;
+    for (const auto &path : searchPaths) {
+        if (QDir::isAbsolutePath(path)) {
+            if (auto dir = QDir::cleanPath(path); !dirs.contains(dir)) {
+                dirs.append(std::move(dir));
+            }
+        }
+    }
+
+    if (m_ready && dirs == m_searchPaths) {
+        return;
+    }
+
+    QList<Directory> newDirs;
+    for (const auto &dir : std::as_const(dirs)) {
+        auto old = std::find_if(m_dirs.begin(), m_dirs.end(), [&dir](const Directory &d) { return d.path == dir; });
+        if (old != m_dirs.end()) {
+            newDirs.append(std::move(*old));
+            continue;
+        }
+
+        // directories which don't exist yet aren't watched, they're picked up by the next PATH change
+        if (m_watcher.addPath(dir)) {
+            newDirs.append(Directory{dir, listExecutables(dir)});
+        }
+    }
+
+    for (const auto &dir : std::as_const(m_dirs)) {
+        if (!dir.path.isEmpty() && !dirs.contains(dir.path)) {
+            m_watcher.removePath(dir.path);
+        }
+    }
+
+    m_searchPaths = std::move(dirs);
+    m_dirs = std::move(newDirs);
+    m_ready = true;
+    rebuild();
+}
+
+void ExecutableIndex::rebuild() noexcept
+{
+    m_executables.clear();
+    for (auto dir = m_dirs.crbegin(); dir != m_dirs.crend(); ++dir) {
+        for (const auto &name : dir->executables) {
+            m_executables.insert(name, dir->path + u'/' + name);
+        }
+    }
+
+    qCDebug(amExecutableIndex) << m_executables.size() << "executables indexed in" << m_dirs.size() << "directories.";
+}
+
+void ExecutableIndex::update(const QString &name) noexcept
+{
+    auto dir = std::find_if(m_dirs.cbegin(), m_dirs.cend(), [&name](const Directory &d) { return d.executables.contains(name); });
+    if (dir == m_dirs.cend()) {
+        m_executables.remove(name);
+        return;
+    }
+
+    m_executables.insert(name, dir->path + u'/' + name);
+}
+
+void ExecutableIndex::onDirectoryChanged(const QString &path) noexcept
+{
+    m_changedDirs.insert(path);
+    m_changeTimer.start();
+}
+
+void ExecutableIndex::applyChanges() noexcept
+{
+    m_changeTimer.stop();
+    const auto changedDirs = std::exchange(m_changedDirs, {});
+    for (const auto &path : changedDirs) {
+        auto dir = std::find_if(m_dirs.begin(), m_dirs.end(), [&path](const Directory &d) { return d.path == path; });
+        if (dir == m_dirs.end()) {
+            continue;
+        }
+
+        auto executables = listExecutables(path);
+        QSet<QString> changed = dir->executables;
+        changed.subtract(executables);
+        for (const auto &name : std::as_const(executables)) {
+            if (!dir->executables.contains(name)) {
+                changed.insert(name);
+            }
+        }
+
+        dir->executables = std::move(executables);
+        for (const auto &name : std::as_const(changed)) {
+            update(name);
+        }
+
+        if (!m_watcher.directories().contains(path)) {
+            m_watcher.addPath(path);
+        }
+        qCDebug(amExecutableIndex) << changed.size() << "executables changed in" << path;
+    }
+}
+
+QString ExecutableIndex::find(const QString &name) const noexcept
+{
+    if (!m_ready || name.contains(u'/')) {
+        return QStandardPaths::findExecutable(name, m_searchPaths);
+    }
+
+    return m_executables.value(name);
+}
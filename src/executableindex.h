@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef EXECUTABLEINDEX_H
+#define EXECUTABLEINDEX_H
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// Executables of every directory in PATH, kept fresh by watching those directories.
+// Resolving a bare program name is a hash lookup instead of a stat(2) per directory.
+class ExecutableIndex : public QObject
+{
+    Q_OBJECT
+public:
+    static ExecutableIndex &instance();
+
+    // directories are listed again only if they're changed
+    void setSearchPaths(const QStringList &searchPaths) noexcept;
+    [[nodiscard]] const QStringList &searchPaths() const noexcept { return m_searchPaths; }
+
+    // same as QStandardPaths::findExecutable, which is used until search paths are set
+    [[nodiscard]] QString find(const QString &name) const noexcept;
+
+private:
+    ExecutableIndex();
+
+    struct Directory
+    {
+        QString path;
+        QSet<QString> executables;
+    };
+
+    bool m_ready{false};
+    QStringList m_searchPaths;
+    QList<Directory> m_dirs;
+    QHash<QString, QString> m_executables;  // name -> path in the first directory providing it
+    QFileSystemWatcher m_watcher;
+    QSet<QString> m_changedDirs;
+    QTimer m_changeTimer;
+
+    void rebuild() noexcept;
+    // resolves name again after directories providing it have changed
+    void update(const QString &name) noexcept;
+    void onDirectoryChanged(const QString &path) noexcept;
+    void applyChanges() noexcept;
+    [[nodiscard]] static QSet<QString> listExecutables(const QString &path) noexcept;
+};
+
+#endif
@@ -30,6 +30,8 @@
 Q_DECLARE_LOGGING_CATEGORY(DDEAMProf)
 Q_DECLARE_LOGGING_CATEGORY(DDEAMUtils)
 
+class QDBusVirtualObject;
+
 using ObjectInterfaceMap = QMap<QString, QVariantMap>;
 using ObjectMap = QMap<QDBusObjectPath, ObjectInterfaceMap>;
 using QStringMap = QMap<QString, QString>;
@@ -125,6 +127,31 @@ inline const QDBusArgument &operator>>(const QDBusArgument &arg, SystemdAux &aux
 }
 // --- Systemd D-Bus 类型定义结束 ---
 
+// result of IdentifyMany for each pidfd: (id, instance, error) -> (sos)
+struct IdentifyResult
+{
+    QString applicationId;
+    QDBusObjectPath instance;  // "/" if not found
+    QString error;             // empty on success
+};
+Q_DECLARE_METATYPE(IdentifyResult)
+
+inline QDBusArgument &operator<<(QDBusArgument &arg, const IdentifyResult &result)
+{
+    arg.beginStructure();
+    arg << result.applicationId << result.instance << result.error;
+    arg.endStructure();
+    return arg;
+}
+
+inline const QDBusArgument &operator>>(const QDBusArgument &arg, IdentifyResult &result)
+{
+    arg.beginStructure();
+    arg >> result.applicationId >> result.instance >> result.error;
+    arg.endStructure();
+    return arg;
+}
+
 inline const QDBusArgument &operator>>(const QDBusArgument &argument, QStringMap &map)
 {
     argument.beginMap();
@@ -326,6 +353,7 @@ private:
 };
 
 bool registerObjectToDBus(QObject *o, const QString &path, const QString &interface) noexcept;
+bool registerVirtualObjectToDBus(QDBusVirtualObject *o, const QString &path) noexcept;
 void unregisterObjectFromDBus(const QString &path) noexcept;
 
 inline const QString &getDBusInterface(const QMetaObject *meta) noexcept
@@ -575,6 +603,12 @@ inline const QString &getXDGDataHome() noexcept
     return value;
 }
 
+inline const QString &getXDGCacheHome() noexcept
+{
+    static const auto &value{QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)};
+    return value;
+}
+
 inline const QStringList &getXDGDataDirs() noexcept
 {
     static const auto &value{QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation)};
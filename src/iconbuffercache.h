@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ICONBUFFERCACHE_H
+#define ICONBUFFERCACHE_H
+
+#include <QString>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// LRU cache of rendered icon buffers which may be attached to several surfaces at once.
+// The compositor sends a single release once it doesn't use a buffer on any surface, so a buffer is busy
+// from an attach until that release and an evicted one is only destroyed once it's released.
+// Buffer::buffer() returns the handle used by the compositor.
+template <typename Buffer>
+class IconBufferCache
+{
+public:
+    using Handle = decltype(std::declval<Buffer &>().buffer());
+
+    explicit IconBufferCache(qsizetype capacity) noexcept
+        : m_capacity(capacity)
+    {
+    }
+
+    // nullopt if key isn't cached, a cached icon which wasn't found has a null buffer
+    [[nodiscard]] std::optional<Buffer *> lookup(const QString &key) noexcept
+    {
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [&key](const Entry &entry) { return entry.key == key; });
+        if (it == m_entries.end()) {
+            return std::nullopt;
+        }
+
+        m_entries.splice(m_entries.begin(), m_entries, it);
+        return m_entries.front().buffer.get();
+    }
+
+    Buffer *insert(const QString &key, std::unique_ptr<Buffer> buffer) noexcept
+    {
+        m_entries.push_front(Entry{key, std::move(buffer), false});
+        while (static_cast<qsizetype>(m_entries.size()) > m_capacity) {
+            drop(std::move(m_entries.back()));
+            m_entries.pop_back();
+        }
+        return m_entries.front().buffer.get();
+    }
+
+    void attach(Handle handle) noexcept
+    {
+        if (auto *entry = find(m_entries, handle); entry != nullptr) {
+            entry->busy = true;
+        }
+    }
+
+    void release(Handle handle) noexcept
+    {
+        if (auto *entry = find(m_entries, handle); entry != nullptr) {
+            entry->busy = false;
+            return;
+        }
+
+        auto it = std::find_if(m_evicted.begin(), m_evicted.end(), [handle](const Entry &entry) {
+            return entry.buffer->buffer() == handle;
+        });
+        if (it != m_evicted.end()) {
+            m_evicted.erase(it);
+        }
+    }
+
+    void clear() noexcept
+    {
+        for (auto &entry : m_entries) {
+            drop(std::move(entry));
+        }
+        m_entries.clear();
+    }
+
+    [[nodiscard]] qsizetype size() const noexcept { return static_cast<qsizetype>(m_entries.size()); }
+    // evicted buffers still used by the compositor
+    [[nodiscard]] qsizetype evictedSize() const noexcept { return static_cast<qsizetype>(m_evicted.size()); }
+
+private:
+    struct Entry
+    {
+        QString key;
+        std::unique_ptr<Buffer> buffer;  // null if icon isn't found
+        bool busy{false};
+    };
+
+    template <typename Container>
+    static Entry *find(Container &entries, Handle handle) noexcept
+    {
+        auto it = std::find_if(entries.begin(), entries.end(), [handle](const Entry &entry) {
+            return entry.buffer && entry.buffer->buffer() == handle;
+        });
+        return it == entries.end() ? nullptr : &*it;
+    }
+
+    void drop(Entry &&entry) noexcept
+    {
+        if (entry.busy && entry.buffer) {
+            m_evicted.push_back(std::move(entry));
+        }
+    }
+
+    std::list<Entry> m_entries;  // most recently used first
+    std::vector<Entry> m_evicted;
+    qsizetype m_capacity;
+};
+
+#endif
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "iconthemeresolver.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QSet>
+
+using namespace Qt::StringLiterals;
+
+Q_LOGGING_CATEGORY(amIconTheme, "dde.am.icon.theme")
+
+namespace {
+const QString FallbackTheme{u"hicolor"_s};
+const QString UnsizedBucket{u"0"_s};
+// lower index is preferred when an icon exists with several extensions
+const QStringList IconExtensions{u"png"_s, u"svg"_s, u"xpm"_s};
+// package upgrades touch a theme many times in a row
+constexpr int InvalidateDelayMs = 500;
+
+qsizetype extensionRank(const QString &fileName, QString &iconName) noexcept
+{
+    const auto dot = fileName.lastIndexOf(u'.');
+    if (dot <= 0) {
+        return -1;
+    }
+
+    auto rank = IconExtensions.indexOf(fileName.sliced(dot + 1));
+    if (rank != -1) {
+        iconName = fileName.first(dot);
+    }
+    return rank;
+}
+}  // namespace
+
+IconThemeResolver::IconThemeResolver(QString themeName, QStringList baseDirs, QStringList pixmapDirs, QObject *parent)
+    : QObject(parent)
+    , m_baseDirs(std::move(baseDirs))
+    , m_pixmapDirs(std::move(pixmapDirs))
+    , m_themeName(std::move(themeName))
+{
+    m_invalidateTimer.setInterval(InvalidateDelayMs);
+    m_invalidateTimer.setSingleShot(true);
+    connect(&m_invalidateTimer, &QTimer::timeout, this, [this]() {
+        invalidate();
+        emit iconFilesChanged();
+    });
+
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &IconThemeResolver::onDirectoryChanged);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
+        qCInfo(amIconTheme) << "theme index" << path << "changed.";
+        scheduleInvalidate();
+    });
+
+    // directories are watched from the start, iconFilesChanged shouldn't depend on someone resolving first
+    load();
+}
+
+QStringList IconThemeResolver::defaultBaseDirs() noexcept
+{
+    QStringList dirs{QDir::homePath() + u"/.icons"_s};
+    for (const auto &dir : getXDGDataDirs()) {
+        dirs.append(dir + u"/icons"_s);
+    }
+    return dirs;
+}
+
+QStringList IconThemeResolver::defaultPixmapDirs() noexcept
+{
+    return {u"/usr/share/pixmaps"_s};
+}
+
+void IconThemeResolver::setThemeName(const QString &themeName) noexcept
+{
+    if (themeName == m_themeName) {
+        return;
+    }
+
+    m_themeName = themeName;
+    invalidate();
+}
+
+void IconThemeResolver::scheduleInvalidate() noexcept
+{
+    m_invalidateTimer.start();
+}
+
+void IconThemeResolver::invalidate() noexcept
+{
+    m_invalidateTimer.stop();
+    if (auto paths = m_watcher.files() + m_watcher.directories(); !paths.isEmpty()) {
+        m_watcher.removePaths(paths);
+    }
+
+    m_dirs.clear();
+    m_dirIndexes.clear();
+    m_resolved.clear();
+    m_rootEntries.clear();
+
+    // re-arm the watches right away
+    load();
+}
+
+QHash<QString, QString> IconThemeResolver::listIcons(const QString &path) noexcept
+{
+    QHash<QString, QString> icons;
+    QHash<QString, qsizetype> ranks;
+    const auto files = QDir{path}.entryList(QDir::Files | QDir::NoDotAndDotDot);
+    for (const auto &file : files) {
+        QString name;
+        auto rank = extensionRank(file, name);
+        if (rank == -1) {
+            continue;
+        }
+
+        if (auto best = ranks.constFind(name); best != ranks.cend() && best.value() <= rank) {
+            continue;
+        }
+
+        ranks.insert(name, rank);
+        icons.insert(name, file);
+    }
+
+    return icons;
+}
+
+QStringList IconThemeResolver::listRootEntries(const QString &path) noexcept
+{
+    // themes and their directories, caches such as icon-theme.cache are rewritten often and don't matter
+    QDir dir{path};
+    auto entries = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    if (dir.exists(u"index.theme"_s)) {
+        entries.append(u"index.theme"_s);
+    }
+    return entries;
+}
+
+std::optional<IconThemeResolver::ThemeIndex> IconThemeResolver::readThemeIndex(const QString &theme) noexcept
+{
+    for (const auto &baseDir : std::as_const(m_baseDirs)) {
+        const auto indexPath = QDir{baseDir}.filePath(theme + u"/index.theme"_s);
+        QFile file{indexPath};
+        if (!file.open(QFile::ReadOnly | QFile::Text)) {
+            continue;
+        }
+        m_watcher.addPath(indexPath);
+
+        ThemeIndex index;
+        QString group;
+        QStringList directories;
+        QHash<QString, QHash<QString, QString>> groups;
+        while (!file.atEnd()) {
+            const auto line = QString::fromUtf8(file.readLine()).trimmed();
+            if (line.isEmpty() || line.startsWith(u'#')) {
+                continue;
+            }
+
+            if (line.startsWith(u'[') && line.endsWith(u']')) {
+                group = line.sliced(1, line.size() - 2);
+                continue;
+            }
+
+            const auto eq = line.indexOf(u'=');
+            if (eq == -1) {
+                continue;
+            }
+
+            const auto key = line.first(eq).trimmed();
+            const auto value = line.sliced(eq + 1).trimmed();
+            if (group == u"Icon Theme"_s) {
+                if (key == u"Inherits"_s) {
+                    index.inherits = value.split(u',', Qt::SkipEmptyParts);
+                } else if (key == u"Directories"_s || key == u"ScaledDirectories"_s) {
+                    directories.append(value.split(u',', Qt::SkipEmptyParts));
+                }
+                continue;
+            }
+
+            groups[group].insert(key, value);
+        }
+
+        for (const auto &dir : std::as_const(directories)) {
+            const auto &keys = groups.value(dir);
+            QString bucket = keys.value(u"Type"_s) == u"Scalable"_s ? u"scalable"_s : keys.value(u"Size"_s);
+            if (bucket.isEmpty()) {
+                continue;
+            }
+
+            if (auto scale = keys.value(u"Scale"_s).toInt(); scale > 1) {
+                bucket += u'@' + QString::number(scale);
+            }
+            index.directories.append({dir, bucket});
+        }
+
+        return index;
+    }
+
+    return std::nullopt;
+}
+
+void IconThemeResolver::addDirectory(const QString &theme, const QString &path, const QString &bucket) noexcept
+{
+    if (m_dirIndexes.contains(path) || !QFileInfo{path}.isDir()) {
+        return;
+    }
+
+    m_watcher.addPath(path);
+    m_dirIndexes.insert(path, m_dirs.size());
+    m_dirs.append(IconDir{theme, path, bucket, listIcons(path)});
+}
+
+void IconThemeResolver::load() noexcept
+{
+    // new themes may be installed into any base directory
+    for (const auto &baseDir : std::as_const(m_baseDirs)) {
+        watchRoot(baseDir);
+    }
+
+    // parents are looked up depth first, hicolor always comes last
+    QStringList chain;
+    QStringList pending{m_themeName.isEmpty() ? FallbackTheme : m_themeName};
+    while (!pending.isEmpty()) {
+        auto theme = pending.takeFirst();
+        if (chain.contains(theme) || (theme == FallbackTheme && !pending.isEmpty())) {
+            continue;
+        }
+        chain.append(theme);
+
+        if (auto index = readThemeIndex(theme); index) {
+            for (const auto &baseDir : std::as_const(m_baseDirs)) {
+                const auto themeDir = QDir{baseDir}.filePath(theme);
+                watchRoot(themeDir);
+
+                for (const auto &[dir, bucket] : std::as_const(index->directories)) {
+                    addDirectory(theme, QDir{themeDir}.filePath(dir), bucket);
+                }
+            }
+            pending = index->inherits + pending;
+        } else {
+            qCDebug(amIconTheme) << "icon theme" << theme << "not found.";
+        }
+
+        if (pending.isEmpty() && !chain.contains(FallbackTheme)) {
+            pending.append(FallbackTheme);
+        }
+    }
+
+    for (const auto &dir : std::as_const(m_pixmapDirs)) {
+        addDirectory({}, dir, UnsizedBucket);
+    }
+
+    qCInfo(amIconTheme) << "icon theme chain" << chain << "loaded with" << m_dirs.size() << "directories.";
+}
+
+void IconThemeResolver::watchRoot(const QString &path) noexcept
+{
+    if (m_rootEntries.contains(path) || !QFileInfo{path}.isDir()) {
+        return;
+    }
+
+    m_watcher.addPath(path);
+    m_rootEntries.insert(path, listRootEntries(path));
+}
+
+void IconThemeResolver::onDirectoryChanged(const QString &path) noexcept
+{
+    auto index = m_dirIndexes.constFind(path);
+    if (index == m_dirIndexes.cend()) {
+        // a base or theme directory, directories of themes may appear or disappear
+        if (auto root = m_rootEntries.find(path); root != m_rootEntries.end()) {
+            auto entries = listRootEntries(path);
+            if (entries == root.value()) {
+                return;
+            }
+            root.value() = std::move(entries);
+        }
+
+        qCInfo(amIconTheme) << "icon theme directory" << path << "changed.";
+        scheduleInvalidate();
+        return;
+    }
+
+    auto &dir = m_dirs[index.value()];
+    auto icons = listIcons(path);
+
+    QSet<QString> changed;
+    for (auto it = dir.icons.cbegin(); it != dir.icons.cend(); ++it) {
+        if (icons.value(it.key()) != it.value()) {
+            changed.insert(it.key());
+        }
+    }
+    for (auto it = icons.cbegin(); it != icons.cend(); ++it) {
+        if (!dir.icons.contains(it.key())) {
+            changed.insert(it.key());
+        }
+    }
+
+    dir.icons = std::move(icons);
+    for (const auto &name : std::as_const(changed)) {
+        m_resolved.remove(name);
+    }
+
+    // the directory may be removed and recreated, watch it again
+    if (!m_watcher.directories().contains(path) && QFileInfo{path}.isDir()) {
+        m_watcher.addPath(path);
+    }
+
+    if (!changed.isEmpty()) {
+        emit iconFilesChanged();
+    }
+}
+
+QStringMap IconThemeResolver::resolve(const QString &iconName) noexcept
+{
+    if (iconName.isEmpty()) {
+        return {};
+    }
+
+    if (QDir::isAbsolutePath(iconName)) {
+        if (QFileInfo::exists(iconName)) {
+            return {{UnsizedBucket, iconName}};
+        }
+        return {};
+    }
+
+    if (auto cached = m_resolved.constFind(iconName); cached != m_resolved.cend()) {
+        return cached.value();
+    }
+
+    // the first theme of chain which provides the icon wins, sizes aren't mixed across themes
+    QStringMap ret;
+    const IconDir *owner{nullptr};
+    for (const auto &dir : std::as_const(m_dirs)) {
+        if (owner != nullptr && dir.theme != owner->theme) {
+            break;
+        }
+
+        auto file = dir.icons.constFind(iconName);
+        if (file == dir.icons.cend()) {
+            continue;
+        }
+
+        owner = &dir;
+        if (!ret.contains(dir.bucket)) {
+            ret.insert(dir.bucket, dir.path + u'/' + file.value());
+        }
+    }
+
+    m_resolved.insert(iconName, ret);
+    return ret;
+}
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef ICONTHEMERESOLVER_H
+#define ICONTHEMERESOLVER_H
+
+#include "global.h"
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <optional>
+
+// Resolves icon names to files following the freedesktop icon theme specification.
+// Icon directories are listed once and watched, so a resolution is made of hash lookups instead of stat(2) calls.
+class IconThemeResolver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IconThemeResolver(QString themeName = {},
+                               QStringList baseDirs = defaultBaseDirs(),
+                               QStringList pixmapDirs = defaultPixmapDirs(),
+                               QObject *parent = nullptr);
+    ~IconThemeResolver() override = default;
+    IconThemeResolver(const IconThemeResolver &) = delete;
+    IconThemeResolver(IconThemeResolver &&) = delete;
+    IconThemeResolver &operator=(const IconThemeResolver &) = delete;
+    IconThemeResolver &operator=(IconThemeResolver &&) = delete;
+
+    // changing the theme drops everything resolved before
+    void setThemeName(const QString &themeName) noexcept;
+    [[nodiscard]] const QString &themeName() const noexcept { return m_themeName; }
+
+    // size bucket -> absolute path, buckets are "<size>", "<size>@<scale>" or "scalable",
+    // files outside of any theme directory, e.g. pixmaps or an absolute icon path, use bucket "0".
+    [[nodiscard]] QStringMap resolve(const QString &iconName) noexcept;
+    // lists and watches the directories of the theme chain again
+    void invalidate() noexcept;
+
+    [[nodiscard]] static QStringList defaultBaseDirs() noexcept;
+    [[nodiscard]] static QStringList defaultPixmapDirs() noexcept;
+
+Q_SIGNALS:
+    // files of watched icon directories or theme indexes have been changed
+    void iconFilesChanged();
+
+private:
+    struct IconDir
+    {
+        QString theme;  // empty for pixmaps
+        QString path;
+        QString bucket;
+        QHash<QString, QString> icons;  // icon name -> file name with the preferred extension
+    };
+
+    struct ThemeIndex
+    {
+        QStringList inherits;
+        QList<std::pair<QString, QString>> directories;  // relative directory -> size bucket
+    };
+
+    QStringList m_baseDirs;
+    QStringList m_pixmapDirs;
+    QString m_themeName;
+    QList<IconDir> m_dirs;  // every directory of the theme chain in lookup order, pixmaps are the last
+    QHash<QString, qsizetype> m_dirIndexes;
+    QHash<QString, QStringMap> m_resolved;
+    QHash<QString, QStringList> m_rootEntries;  // base or theme directory -> entries which affect the theme chain
+    QFileSystemWatcher m_watcher;
+    QTimer m_invalidateTimer;
+
+    void load() noexcept;
+    void watchRoot(const QString &path) noexcept;
+    void scheduleInvalidate() noexcept;
+    void addDirectory(const QString &theme, const QString &path, const QString &bucket) noexcept;
+    void onDirectoryChanged(const QString &path) noexcept;
+    [[nodiscard]] std::optional<ThemeIndex> readThemeIndex(const QString &theme) noexcept;
+    [[nodiscard]] static QHash<QString, QString> listIcons(const QString &path) noexcept;
+    [[nodiscard]] static QStringList listRootEntries(const QString &path) noexcept;
+};
+
+#endif
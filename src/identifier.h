@@ -9,10 +9,18 @@
 #include <QDBusUnixFileDescriptor>
 #include <unistd.h>
 
+enum class IdentifyConfidence : quint8 {
+    None = 0,
+    Low,     // matched by the command line, or by an executable shared by several applications
+    Medium,  // matched by the executable of process
+    High,    // process runs in the systemd unit of an application instance
+};
+
 struct IdentifyRet
 {
     QString ApplicationId;
     QString InstanceId;
+    IdentifyConfidence Confidence{IdentifyConfidence::None};
 };
 
 class Identifier
@@ -20,6 +28,8 @@ class Identifier
 public:
     virtual ~Identifier() = default;
     virtual IdentifyRet Identify(const QDBusUnixFileDescriptor &pidfd) = 0;
+    // drops whatever has been remembered about processes of the unit
+    virtual void unitRemoved([[maybe_unused]] const QString &unitName) noexcept {}
 };
 
 #endif
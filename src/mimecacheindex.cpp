@@ -0,0 +1,380 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mimecacheindex.h"
+#include "constant.h"
+#include "global.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+class StringPool
+{
+public:
+    MimeCacheIndexString add(const QByteArray &utf8) noexcept
+    {
+        MimeCacheIndexString ret{static_cast<quint32>(m_data.size()), static_cast<quint32>(utf8.size())};
+        m_data.append(utf8);
+        return ret;
+    }
+
+    [[nodiscard]] const QByteArray &data() const noexcept { return m_data; }
+
+private:
+    QByteArray m_data;
+};
+
+QString sidecarDir() noexcept
+{
+    return getXDGCacheHome() + fromStaticRaw(MimeCacheIndexDir);
+}
+
+QString sidecarNameOf(const QString &sourcePath) noexcept
+{
+    const auto hash = QCryptographicHash::hash(QFile::encodeName(sourcePath), QCryptographicHash::Sha1).toHex();
+    return QString::fromLatin1(hash) + u".idx";
+}
+
+template <typename T>
+void appendRaw(QByteArray &dest, const T *data, size_t count) noexcept
+{
+    dest.append(reinterpret_cast<const char *>(data), static_cast<qsizetype>(count * sizeof(T)));
+}
+}  // namespace
+
+MimeCacheIndex::~MimeCacheIndex()
+{
+    if (m_mapped) {
+        ::munmap(const_cast<char *>(m_data), m_size);
+    }
+}
+
+QString MimeCacheIndex::sidecarPathOf(const QString &sourcePath) noexcept
+{
+    return QDir{sidecarDir()}.filePath(sidecarNameOf(sourcePath));
+}
+
+void MimeCacheIndex::prune(const QStringList &sourcePaths) noexcept
+{
+    QSet<QString> used;
+    used.reserve(sourcePaths.size());
+    for (const auto &sourcePath : sourcePaths) {
+        used.insert(sidecarNameOf(sourcePath));
+    }
+
+    QDir dir{sidecarDir()};
+    const auto sidecars = dir.entryList({u"*.idx"_s}, QDir::Files);
+    for (const auto &sidecar : sidecars) {
+        if (used.contains(sidecar)) {
+            continue;
+        }
+
+        if (!dir.remove(sidecar)) {
+            qWarning() << "failed to remove unused mime cache index" << dir.filePath(sidecar);
+        }
+    }
+}
+
+QByteArray MimeCacheIndex::compile(const MimeFileParser::Groups &content, qint64 sourceMtime, qint64 sourceSize) noexcept
+{
+    // type (UTF-8) -> app ids (UTF-8, without suffix) in the order of the source
+    std::map<QByteArray, QList<QByteArray>> typeApps;
+    std::map<QByteArray, quint32> appIndexes;
+    if (auto section = content.constFind(fromStaticRaw(mimeCache)); section != content.cend()) {
+        for (const auto &[type, apps] : section->asKeyValueRange()) {
+            auto &ids = typeApps[type.toUtf8()];
+            for (const auto &app : apps) {
+                if (!app.endsWith(desktopSuffix)) {
+                    continue;
+                }
+
+                auto id = app.chopped(desktopSuffix.size()).toUtf8();
+                appIndexes.emplace(id, 0);
+                ids.append(std::move(id));
+            }
+        }
+    }
+
+    quint32 nextIndex{0};
+    for (auto &[id, index] : appIndexes) {
+        index = nextIndex++;
+    }
+
+    StringPool pool;
+    std::vector<MimeCacheIndexRecord> types;
+    types.reserve(typeApps.size());
+    std::vector<quint32> refs;
+    std::vector<std::vector<quint32>> appTypes(appIndexes.size());
+    for (const auto &[type, ids] : typeApps) {
+        const auto typeIndex = static_cast<quint32>(types.size());
+        MimeCacheIndexRecord record{pool.add(type), static_cast<quint32>(refs.size()), static_cast<quint32>(ids.size())};
+        for (const auto &id : ids) {
+            const auto appIndex = appIndexes.at(id);
+            refs.push_back(appIndex);
+            // types are visited in ascending order, so checking the last one keeps them unique
+            if (auto &indexes = appTypes[appIndex]; indexes.empty() || indexes.back() != typeIndex) {
+                indexes.push_back(typeIndex);
+            }
+        }
+        types.push_back(record);
+    }
+
+    std::vector<MimeCacheIndexRecord> apps;
+    apps.reserve(appIndexes.size());
+    for (const auto &[id, index] : appIndexes) {
+        const auto &indexes = appTypes[index];
+        apps.push_back(MimeCacheIndexRecord{pool.add(id), static_cast<quint32>(refs.size()), static_cast<quint32>(indexes.size())});
+        refs.insert(refs.end(), indexes.cbegin(), indexes.cend());
+    }
+
+    MimeCacheIndexHeader header{};
+    std::memcpy(header.magic, MimeCacheIndexMagic, sizeof(MimeCacheIndexMagic));
+    header.version = MimeCacheIndexVersion;
+    header.sourceMtime = sourceMtime;
+    header.sourceSize = sourceSize;
+    header.typeCount = static_cast<quint32>(types.size());
+    header.appCount = static_cast<quint32>(apps.size());
+    header.typesOffset = sizeof(MimeCacheIndexHeader);
+    header.appsOffset = header.typesOffset + static_cast<quint32>(types.size() * sizeof(MimeCacheIndexRecord));
+    header.refsOffset = header.appsOffset + static_cast<quint32>(apps.size() * sizeof(MimeCacheIndexRecord));
+    header.refCount = static_cast<quint32>(refs.size());
+    header.stringsOffset = header.refsOffset + static_cast<quint32>(refs.size() * sizeof(quint32));
+    header.stringsSize = static_cast<quint32>(pool.data().size());
+
+    QByteArray ret;
+    ret.reserve(header.stringsOffset + header.stringsSize);
+    appendRaw(ret, &header, 1);
+    appendRaw(ret, types.data(), types.size());
+    appendRaw(ret, apps.data(), apps.size());
+    appendRaw(ret, refs.data(), refs.size());
+    ret.append(pool.data());
+    return ret;
+}
+
+std::shared_ptr<const MimeCacheIndex> MimeCacheIndex::load(const QString &sourcePath, const QString &sidecarPath) noexcept
+{
+    // take the stamp before parsing, a write racing with us will be picked up by the next check
+    struct stat st{};
+    if (::stat(QFile::encodeName(sourcePath).constData(), &st) == -1) {
+        return nullptr;
+    }
+
+    const auto mtime = static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    const auto size = static_cast<qint64>(st.st_size);
+    const auto sidecar = sidecarPath.isEmpty() ? sidecarPathOf(sourcePath) : sidecarPath;
+    if (auto index = map(sidecar); index && index->sourceMtime() == mtime && index->sourceSize() == size) {
+        return index;
+    }
+
+    QFile file{sourcePath};
+    if (!file.open(QFile::ReadOnly | QFile::Text | QFile::ExistingOnly)) {
+        qWarning() << "open" << sourcePath << "failed:" << file.errorString();
+        return nullptr;
+    }
+
+    MimeFileParser::Groups content;
+    MimeFileParser parser{file, false};
+    if (auto err = parser.parse(content); err != ParserError::NoError) {
+        qWarning() << "file:" << sourcePath << "parse failed:" << err;
+        return nullptr;
+    }
+
+    auto data = compile(content, mtime, size);
+    content.clear();
+
+    QSaveFile out{sidecar};
+    if (QDir{}.mkpath(QFileInfo{sidecar}.absolutePath()) && out.open(QFile::WriteOnly) &&
+        out.write(data) == data.size() && out.commit()) {
+        if (auto index = map(sidecar); index) {
+            return index;
+        }
+    } else {
+        qWarning() << "failed to write mime cache index" << sidecar << ":" << out.errorString();
+    }
+
+    return fromBuffer(std::move(data));
+}
+
+std::shared_ptr<MimeCacheIndex> MimeCacheIndex::map(const QString &sidecarPath) noexcept
+{
+    auto fd = ::open(QFile::encodeName(sidecarPath).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) == -1 || st.st_size < static_cast<off_t>(sizeof(MimeCacheIndexHeader))) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    auto *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::shared_ptr<MimeCacheIndex> ret{new (std::nothrow) MimeCacheIndex};
+    if (!ret) {
+        ::munmap(addr, static_cast<size_t>(st.st_size));
+        return nullptr;
+    }
+
+    ret->m_data = static_cast<const char *>(addr);
+    ret->m_size = static_cast<size_t>(st.st_size);
+    ret->m_mapped = true;
+    if (!ret->validate()) {
+        qWarning() << "mime cache index" << sidecarPath << "is broken, it will be compiled again.";
+        return nullptr;
+    }
+
+    return ret;
+}
+
+std::shared_ptr<MimeCacheIndex> MimeCacheIndex::fromBuffer(QByteArray buffer) noexcept
+{
+    std::shared_ptr<MimeCacheIndex> ret{new (std::nothrow) MimeCacheIndex};
+    if (!ret) {
+        return nullptr;
+    }
+
+    ret->m_buffer = std::move(buffer);
+    ret->m_data = ret->m_buffer.constData();
+    ret->m_size = static_cast<size_t>(ret->m_buffer.size());
+    return ret->validate() ? ret : nullptr;
+}
+
+const MimeCacheIndexRecord *MimeCacheIndex::typeRecords() const noexcept
+{
+    return reinterpret_cast<const MimeCacheIndexRecord *>(m_data + header()->typesOffset);
+}
+
+const MimeCacheIndexRecord *MimeCacheIndex::appRecords() const noexcept
+{
+    return reinterpret_cast<const MimeCacheIndexRecord *>(m_data + header()->appsOffset);
+}
+
+const quint32 *MimeCacheIndex::refs() const noexcept
+{
+    return reinterpret_cast<const quint32 *>(m_data + header()->refsOffset);
+}
+
+QString MimeCacheIndex::toString(const MimeCacheIndexString &str) const noexcept
+{
+    return QString::fromUtf8(m_data + header()->stringsOffset + str.offset, str.size);
+}
+
+const MimeCacheIndexRecord *
+MimeCacheIndex::find(const MimeCacheIndexRecord *records, quint32 count, const QString &name) const noexcept
+{
+    const auto key = name.toUtf8();
+    const auto *strings = m_data + header()->stringsOffset;
+    const auto *end = records + count;
+    const auto *it = std::lower_bound(records, end, key, [strings](const MimeCacheIndexRecord &record, const QByteArray &value) {
+        return QByteArrayView{strings + record.name.offset, record.name.size} < QByteArrayView{value};
+    });
+
+    if (it == end || QByteArrayView{strings + it->name.offset, it->name.size} != QByteArrayView{key}) {
+        return nullptr;
+    }
+
+    return it;
+}
+
+QStringList MimeCacheIndex::appsOf(const QString &type) const noexcept
+{
+    const auto *record = find(typeRecords(), header()->typeCount, type);
+    if (record == nullptr) {
+        return {};
+    }
+
+    const auto *apps = appRecords();
+    QStringList ret;
+    ret.reserve(record->count);
+    for (quint32 i = 0; i < record->count; ++i) {
+        ret.append(toString(apps[refs()[record->first + i]].name));
+    }
+
+    return ret;
+}
+
+QStringList MimeCacheIndex::typesOf(const QString &appId) const noexcept
+{
+    const auto *record = find(appRecords(), header()->appCount, appId);
+    if (record == nullptr) {
+        return {};
+    }
+
+    const auto *types = typeRecords();
+    QStringList ret;
+    ret.reserve(record->count);
+    for (quint32 i = 0; i < record->count; ++i) {
+        ret.append(toString(types[refs()[record->first + i]].name));
+    }
+
+    return ret;
+}
+
+QStringList MimeCacheIndex::types() const noexcept
+{
+    const auto *types = typeRecords();
+    QStringList ret;
+    ret.reserve(header()->typeCount);
+    for (quint32 i = 0; i < header()->typeCount; ++i) {
+        ret.append(toString(types[i].name));
+    }
+
+    return ret;
+}
+
+bool MimeCacheIndex::validate() const noexcept
+{
+    const auto *head = header();
+    if (std::memcmp(head->magic, MimeCacheIndexMagic, sizeof(MimeCacheIndexMagic)) != 0 ||
+        head->version != MimeCacheIndexVersion) {
+        return false;
+    }
+
+    const auto typesEnd = static_cast<quint64>(head->typesOffset) + static_cast<quint64>(head->typeCount) * sizeof(MimeCacheIndexRecord);
+    const auto appsEnd = static_cast<quint64>(head->appsOffset) + static_cast<quint64>(head->appCount) * sizeof(MimeCacheIndexRecord);
+    const auto refsEnd = static_cast<quint64>(head->refsOffset) + static_cast<quint64>(head->refCount) * sizeof(quint32);
+    if (head->typesOffset % alignof(MimeCacheIndexRecord) != 0 || head->appsOffset % alignof(MimeCacheIndexRecord) != 0 ||
+        head->refsOffset % alignof(quint32) != 0 || typesEnd > m_size || appsEnd > m_size || refsEnd > m_size ||
+        static_cast<quint64>(head->stringsOffset) + head->stringsSize > m_size) {
+        return false;
+    }
+
+    auto validRecords = [this, head](const MimeCacheIndexRecord *records, quint32 count, quint32 targetCount) {
+        for (quint32 i = 0; i < count; ++i) {
+            const auto &record = records[i];
+            if (static_cast<quint64>(record.name.offset) + record.name.size > head->stringsSize ||
+                static_cast<quint64>(record.first) + record.count > head->refCount) {
+                return false;
+            }
+
+            for (quint32 j = 0; j < record.count; ++j) {
+                if (refs()[record.first + j] >= targetCount) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    return validRecords(typeRecords(), head->typeCount, head->appCount) &&
+           validRecords(appRecords(), head->appCount, head->typeCount);
+}
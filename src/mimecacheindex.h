@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MIMECACHEINDEX_H
+#define MIMECACHEINDEX_H
+
+#include "mimefileparser.h"
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+// Compiled form of a mimeinfo.cache, stored as a sidecar under $XDG_CACHE_HOME and queried through mmap.
+// The sidecar records mtime and size of its source and is compiled again only when they change.
+
+constexpr static char MimeCacheIndexMagic[4]{'D', 'A', 'M', 'C'};
+constexpr static quint32 MimeCacheIndexVersion = 1;
+
+struct MimeCacheIndexHeader
+{
+    char magic[4];
+    quint32 version;
+    qint64 sourceMtime;  // nsecs
+    qint64 sourceSize;
+    quint32 typeCount;
+    quint32 appCount;
+    quint32 typesOffset;
+    quint32 appsOffset;
+    quint32 refsOffset;
+    quint32 refCount;
+    quint32 stringsOffset;
+    quint32 stringsSize;
+};
+
+struct MimeCacheIndexString
+{
+    quint32 offset;
+    quint32 size;
+};
+
+// types and apps are sorted by the UTF-8 bytes of name, [first, first + count) is a range of the refs array.
+// refs of a type are indexes of apps in the order of the source, refs of an app are unique indexes of types.
+struct MimeCacheIndexRecord
+{
+    MimeCacheIndexString name;
+    quint32 first;
+    quint32 count;
+};
+
+static_assert(sizeof(MimeCacheIndexHeader) == 56, "layout of MimeCacheIndexHeader is part of the sidecar format");
+static_assert(sizeof(MimeCacheIndexRecord) == 16, "layout of MimeCacheIndexRecord is part of the sidecar format");
+
+class MimeCacheIndex
+{
+public:
+    ~MimeCacheIndex();
+    MimeCacheIndex(const MimeCacheIndex &) = delete;
+    MimeCacheIndex(MimeCacheIndex &&) = delete;
+    MimeCacheIndex &operator=(const MimeCacheIndex &) = delete;
+    MimeCacheIndex &operator=(MimeCacheIndex &&) = delete;
+
+    // maps the sidecar of sourcePath, compiles it first if it's missing or stale.
+    // if the sidecar can't be written the compiled index is kept in memory.
+    [[nodiscard]] static std::shared_ptr<const MimeCacheIndex> load(const QString &sourcePath,
+                                                                    const QString &sidecarPath = {}) noexcept;
+    [[nodiscard]] static QByteArray
+    compile(const MimeFileParser::Groups &content, qint64 sourceMtime, qint64 sourceSize) noexcept;
+    [[nodiscard]] static QString sidecarPathOf(const QString &sourcePath) noexcept;
+    // removes sidecars under $XDG_CACHE_HOME which don't belong to any of sourcePaths
+    static void prune(const QStringList &sourcePaths) noexcept;
+
+    [[nodiscard]] qint64 sourceMtime() const noexcept { return header()->sourceMtime; }
+    [[nodiscard]] qint64 sourceSize() const noexcept { return header()->sourceSize; }
+    [[nodiscard]] qsizetype typeCount() const noexcept { return header()->typeCount; }
+
+    // app ids are without .desktop suffix
+    [[nodiscard]] QStringList appsOf(const QString &type) const noexcept;
+    [[nodiscard]] QStringList typesOf(const QString &appId) const noexcept;
+    [[nodiscard]] QStringList types() const noexcept;
+
+private:
+    MimeCacheIndex() = default;
+
+    const char *m_data{nullptr};
+    size_t m_size{0};
+    bool m_mapped{false};
+    QByteArray m_buffer;  // used if the sidecar isn't available
+
+    [[nodiscard]] static std::shared_ptr<MimeCacheIndex> map(const QString &sidecarPath) noexcept;
+    [[nodiscard]] static std::shared_ptr<MimeCacheIndex> fromBuffer(QByteArray buffer) noexcept;
+
+    [[nodiscard]] const MimeCacheIndexHeader *header() const noexcept
+    {
+        return reinterpret_cast<const MimeCacheIndexHeader *>(m_data);
+    }
+    [[nodiscard]] const MimeCacheIndexRecord *typeRecords() const noexcept;
+    [[nodiscard]] const MimeCacheIndexRecord *appRecords() const noexcept;
+    [[nodiscard]] const quint32 *refs() const noexcept;
+    [[nodiscard]] QString toString(const MimeCacheIndexString &str) const noexcept;
+    [[nodiscard]] const MimeCacheIndexRecord *
+    find(const MimeCacheIndexRecord *records, quint32 count, const QString &name) const noexcept;
+    [[nodiscard]] bool validate() const noexcept;
+};
+
+#endif
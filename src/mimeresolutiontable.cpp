@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mimeresolutiontable.h"
+#include "constant.h"
+#include "global.h"
+#include <QQueue>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+const QStringList *findApps(const MimeContent &content, const QString &group, const QString &type) noexcept
+{
+    auto section = content.constFind(group);
+    if (section == content.cend()) {
+        return nullptr;
+    }
+
+    auto apps = section->constFind(type);
+    return apps == section->cend() ? nullptr : &apps.value();
+}
+
+void appendApps(QStringList &dest, const QStringList *apps, const QSet<QString> &excluded = {}) noexcept
+{
+    if (apps == nullptr) {
+        return;
+    }
+
+    for (const auto &app : *apps) {
+        if (!app.endsWith(desktopSuffix)) {
+            continue;
+        }
+
+        auto appId = app.chopped(desktopSuffix.size());
+        if (!excluded.contains(appId) && !dest.contains(appId)) {
+            dest.append(std::move(appId));
+        }
+    }
+}
+}  // namespace
+
+void MimeResolutionTable::clear() noexcept
+{
+    m_sources.clear();
+    m_table.clear();
+    m_defaultMemo.clear();
+}
+
+void MimeResolutionTable::collectTypes(const MimeContent &content, QSet<QString> &types) noexcept
+{
+    for (const auto &section : content) {
+        for (auto it = section.cbegin(); it != section.cend(); ++it) {
+            types.insert(it.key());
+        }
+    }
+}
+
+void MimeResolutionTable::rebuild(const std::vector<MimeInfo> &infos) noexcept
+{
+    clear();
+
+    QSet<QString> types;
+    for (const auto &info : infos) {
+        for (const auto &apps : info.appsList()) {
+            m_sources.push_back(Source{apps.fileInfo().absoluteFilePath(), apps.content(), nullptr});
+            collectTypes(apps.content(), types);
+        }
+
+        // caches don't take part in resolving defaults and associations, no need to visit their types
+        if (const auto &cache = info.cacheInfo(); cache) {
+            m_sources.push_back(Source{cache->fileInfo().absoluteFilePath(), {}, cache->index()});
+        }
+    }
+
+    m_table.reserve(types.size());
+    for (const auto &type : std::as_const(types)) {
+        resolve(type);
+    }
+}
+
+bool MimeResolutionTable::updateFile(const MimeFileBase &file) noexcept
+{
+    const auto path = file.fileInfo().absoluteFilePath();
+    auto source = std::find_if(m_sources.begin(), m_sources.end(), [&path](const Source &s) { return s.path == path; });
+    if (source == m_sources.end()) {
+        return false;
+    }
+
+    if (const auto *cache = dynamic_cast<const MimeCache *>(&file); cache != nullptr) {
+        source->cache = cache->index();
+        return true;
+    }
+
+    QSet<QString> types;
+    collectTypes(source->content, types);
+    collectTypes(file.content(), types);
+    source->content = file.content();
+    // a changed type may be the ancestor of any memoized one
+    m_defaultMemo.clear();
+
+    for (const auto &type : std::as_const(types)) {
+        resolve(type);
+    }
+
+    return true;
+}
+
+void MimeResolutionTable::resolve(const QString &type) noexcept
+{
+    MimeResolution ret;
+    QSet<QString> removed;
+
+    for (const auto &source : m_sources) {
+        if (source.cache) {
+            continue;
+        }
+
+        appendApps(ret.defaults, findApps(source.content, fromStaticRaw(defaultApplications), type));
+
+        // removals apply to the file itself and to every file of lower precedence
+        QStringList removedHere;
+        appendApps(removedHere, findApps(source.content, fromStaticRaw(removedAssociations), type));
+        for (auto &app : removedHere) {
+            if (!removed.contains(app)) {
+                removed.insert(app);
+                ret.removed.append(std::move(app));
+            }
+        }
+
+        appendApps(ret.added, findApps(source.content, fromStaticRaw(addedAssociations), type), removed);
+    }
+
+    if (ret.defaults.isEmpty() && ret.added.isEmpty() && ret.removed.isEmpty()) {
+        m_table.remove(type);
+        return;
+    }
+
+    m_table.insert(type, std::move(ret));
+}
+
+const MimeResolution *MimeResolutionTable::find(const QString &type) const noexcept
+{
+    auto it = m_table.constFind(type);
+    return it == m_table.cend() ? nullptr : &it.value();
+}
+
+QStringList MimeResolutionTable::cachedApplications(const QString &type) const noexcept
+{
+    QStringList ret;
+    for (const auto &source : m_sources) {
+        if (!source.cache) {
+            continue;
+        }
+
+        const auto apps = source.cache->appsOf(type);
+        for (const auto &app : apps) {
+            if (!ret.contains(app)) {
+                ret.append(app);
+            }
+        }
+    }
+
+    return ret;
+}
+
+QString MimeResolutionTable::defaultApplication(const QString &type) const noexcept
+{
+    const auto *resolution = find(type);
+    return resolution == nullptr || resolution->defaults.isEmpty() ? QString{} : resolution->defaults.constFirst();
+}
+
+MimeDefault MimeResolutionTable::resolveDefault(const QString &type) const noexcept
+{
+    if (auto memo = m_defaultMemo.constFind(type); memo != m_defaultMemo.cend()) {
+        return memo.value();
+    }
+
+    MimeDefault ret;
+    const auto mime = m_database.mimeTypeForName(type);
+    if (!mime.isValid()) {
+        // unknown to shared-mime-info, only the raw type could match
+        // it's as cheap as the memo, and clients could fill the memo with arbitrary strings
+        ret.appId = defaultApplication(type);
+        if (!ret.appId.isEmpty()) {
+            ret.matchedType = type;
+        }
+        return ret;
+    }
+
+    if (m_defaultMemo.size() >= DefaultMemoCapacity) {
+        m_defaultMemo.clear();
+    }
+
+    QSet<QString> visited{mime.name()};
+    QQueue<QMimeType> pending;
+    pending.enqueue(mime);
+    while (!pending.isEmpty()) {
+        const auto current = pending.dequeue();
+
+        // mimeapps.list may still refer to a type by one of its aliases
+        QStringList candidates{current.name()};
+        candidates.append(current.aliases());
+        if (current.name() == mime.name() && !candidates.contains(type)) {
+            candidates.append(type);
+        }
+
+        for (const auto &candidate : std::as_const(candidates)) {
+            if (auto appId = defaultApplication(candidate); !appId.isEmpty()) {
+                ret.appId = std::move(appId);
+                ret.matchedType = candidate;
+                m_defaultMemo.insert(type, ret);
+                return ret;
+            }
+        }
+
+        const auto parents = current.parentMimeTypes();
+        for (const auto &parent : parents) {
+            if (visited.contains(parent)) {
+                continue;
+            }
+            visited.insert(parent);
+
+            if (auto parentType = m_database.mimeTypeForName(parent); parentType.isValid()) {
+                pending.enqueue(std::move(parentType));
+            }
+        }
+    }
+
+    m_defaultMemo.insert(type, ret);
+    return ret;
+}
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MIMERESOLUTIONTABLE_H
+#define MIMERESOLUTIONTABLE_H
+
+#include "applicationmimeinfo.h"
+#include <QHash>
+#include <QMimeDatabase>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <vector>
+
+// app ids are stored without the .desktop suffix
+struct MimeResolution
+{
+    QStringList defaults;  // in precedence order, the first one is the default application
+    QStringList added;     // associations not removed by a file of higher or same precedence
+    QStringList removed;
+};
+
+struct MimeDefault
+{
+    QString appId;        // empty if no default application is found
+    QString matchedType;  // the type, alias or ancestor which the default application is configured for
+};
+
+// Merges mimeapps.list and mimeinfo.cache files of all mime directories into one table.
+// Sources are kept in precedence order: directories as getMimeDirs(), desktop specific lists before mimeapps.list.
+class MimeResolutionTable
+{
+public:
+    MimeResolutionTable() = default;
+    ~MimeResolutionTable() = default;
+    MimeResolutionTable(const MimeResolutionTable &) = delete;
+    MimeResolutionTable(MimeResolutionTable &&) = delete;
+    MimeResolutionTable &operator=(const MimeResolutionTable &) = delete;
+    MimeResolutionTable &operator=(MimeResolutionTable &&) = delete;
+
+    void rebuild(const std::vector<MimeInfo> &infos) noexcept;
+    // only types mentioned by the old or new content of file are resolved again,
+    // returns false if file isn't one of sources.
+    bool updateFile(const MimeFileBase &file) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] const MimeResolution *find(const QString &type) const noexcept;
+    // merged mimeinfo.cache of every directory, looked up in the mapped indexes on demand
+    [[nodiscard]] QStringList cachedApplications(const QString &type) const noexcept;
+    // exact lookup, neither aliases nor parents are considered
+    [[nodiscard]] QString defaultApplication(const QString &type) const noexcept;
+    // walks aliases and the shared-mime-info inheritance chain breadth first, results are memoized until the table changes.
+    [[nodiscard]] MimeDefault resolveDefault(const QString &type) const noexcept;
+    [[nodiscard]] qsizetype size() const noexcept { return m_table.size(); }
+
+    // only types known to shared-mime-info are memoized, the memo is dropped once it reaches the capacity
+    constexpr static qsizetype DefaultMemoCapacity = 4096;
+
+private:
+    struct Source
+    {
+        QString path;
+        MimeContent content;                           // implicitly shared with mimeapps.list
+        std::shared_ptr<const MimeCacheIndex> cache;  // set for mimeinfo.cache
+    };
+
+    std::vector<Source> m_sources;
+    QHash<QString, MimeResolution> m_table;
+    QMimeDatabase m_database;
+    mutable QHash<QString, MimeDefault> m_defaultMemo;
+
+    void resolve(const QString &type) noexcept;
+    static void collectTypes(const MimeContent &content, QSet<QString> &types) noexcept;
+};
+
+#endif
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mimetypesniffer.h"
+#include <QDir>
+#include <QFile>
+#include <QtConcurrentMap>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+namespace {
+// same as the amount of data QMimeDatabase reads from a device
+constexpr qint64 SniffSize = 16384;
+}  // namespace
+
+std::optional<MimeTypeSniffer::FileKey> MimeTypeSniffer::keyOf(const QString &path) noexcept
+{
+    if (!QDir::isAbsolutePath(path)) {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (::stat(QFile::encodeName(path).constData(), &st) == -1) {
+        return std::nullopt;
+    }
+
+    return FileKey{path,
+                   static_cast<quint64>(st.st_dev),
+                   static_cast<quint64>(st.st_ino),
+                   static_cast<qint64>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec,
+                   static_cast<qint64>(st.st_size),
+                   S_ISREG(st.st_mode)};
+}
+
+QStringList MimeTypeSniffer::mimeTypesForFiles(const QStringList &paths) noexcept
+{
+    struct Pending
+    {
+        FileKey key;
+        QString type;
+    };
+
+    QStringList ret;
+    ret.reserve(paths.size());
+    std::vector<Pending> pending;
+    QHash<FileKey, size_t> pendingIndexes;  // the same file may be passed more than once
+    std::vector<std::pair<qsizetype, size_t>> unresolved;
+
+    for (qsizetype i = 0; i < paths.size(); ++i) {
+        ret.append(QString{});
+        const auto key = keyOf(paths.at(i));
+        if (!key) {
+            continue;
+        }
+
+        if (auto cached = m_cache.constFind(*key); cached != m_cache.cend()) {
+            ret[i] = cached.value();
+            continue;
+        }
+
+        auto index = pendingIndexes.constFind(*key);
+        if (index == pendingIndexes.cend()) {
+            index = pendingIndexes.insert(*key, pending.size());
+            pending.push_back(Pending{*key, {}});
+        }
+        unresolved.emplace_back(i, index.value());
+    }
+
+    // QMimeDatabase serializes lookups with a mutex, so read the content outside of it.
+    auto sniff = [this](Pending &p) {
+        // directories, FIFOs, sockets and devices are typed by QMimeDatabase without reading them
+        if (!p.key.regular) {
+            p.type = m_database.mimeTypeForFile(p.key.path).name();
+            return;
+        }
+
+        QFile file{p.key.path};
+        if (!file.open(QFile::ReadOnly)) {
+            // unreadable files
+            p.type = m_database.mimeTypeForFile(p.key.path).name();
+            return;
+        }
+
+        p.type = m_database.mimeTypeForFileNameAndData(p.key.path, file.read(SniffSize)).name();
+    };
+    if (pending.size() == 1) {
+        sniff(pending.front());
+    } else if (!pending.empty()) {
+        QtConcurrent::blockingMap(pending, sniff);
+    }
+
+    for (const auto &[retIndex, pendingIndex] : unresolved) {
+        ret[retIndex] = pending[pendingIndex].type;
+    }
+
+    if (m_cache.size() + static_cast<qsizetype>(pending.size()) > m_capacity) {
+        m_cache.clear();
+    }
+
+    for (auto &p : pending) {
+        if (m_cache.size() >= m_capacity) {
+            break;
+        }
+        m_cache.insert(p.key, std::move(p.type));
+    }
+
+    return ret;
+}
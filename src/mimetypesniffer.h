@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef MIMETYPESNIFFER_H
+#define MIMETYPESNIFFER_H
+
+#include <QHash>
+#include <QMimeDatabase>
+#include <QString>
+#include <QStringList>
+#include <optional>
+
+// Detects MIME types of many files at once, content sniffing runs on the global thread pool.
+// Results are cached by (path, device, inode, mtime, size), so a file is only sniffed again after it's modified.
+// The path is part of the key since the type also depends on the file name, which renames and hard links change.
+class MimeTypeSniffer
+{
+public:
+    struct FileKey
+    {
+        QString path;
+        quint64 device{0};
+        quint64 inode{0};
+        qint64 mtime{0};  // nsecs
+        qint64 size{0};
+        bool regular{true};  // only regular files are opened, a FIFO blocks open(2) until a writer shows up
+
+        friend bool operator==(const FileKey &lhs, const FileKey &rhs) noexcept
+        {
+            return lhs.path == rhs.path && lhs.device == rhs.device && lhs.inode == rhs.inode && lhs.mtime == rhs.mtime && lhs.size == rhs.size &&
+                   lhs.regular == rhs.regular;
+        }
+    };
+
+    constexpr static qsizetype DefaultCapacity = 8192;
+
+    explicit MimeTypeSniffer(qsizetype capacity = DefaultCapacity) noexcept
+        : m_capacity(capacity)
+    {
+    }
+
+    // the result is in the same order as paths, it's empty for a path which isn't an absolute path of an existing file
+    [[nodiscard]] QStringList mimeTypesForFiles(const QStringList &paths) noexcept;
+    void clear() noexcept { m_cache.clear(); }
+    [[nodiscard]] qsizetype cacheSize() const noexcept { return m_cache.size(); }
+
+    [[nodiscard]] static std::optional<FileKey> keyOf(const QString &path) noexcept;
+
+private:
+    QMimeDatabase m_database;
+    QHash<FileKey, QString> m_cache;
+    qsizetype m_capacity;
+};
+
+inline size_t qHash(const MimeTypeSniffer::FileKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.path, key.device, key.inode, key.mtime, key.size, key.regular);
+}
+
+#endif
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "packageindex.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFuture>
+#include <QLoggingCategory>
+#include <QtConcurrentRun>
+#include <cstring>
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+Q_LOGGING_CATEGORY(amPackageIndex, "dde.am.package.index")
+
+namespace {
+constexpr auto DpkgDir = "/var/lib/dpkg";
+constexpr QByteArrayView ApplicationsDir{"/applications/"};
+constexpr QByteArrayView DesktopSuffix{".desktop"};
+
+template <typename Func>
+void forEachLine(QByteArrayView content, Func &&func)
+{
+    const auto *begin = content.data();
+    const auto *end = begin + content.size();
+    while (begin < end) {
+        const auto *lineEnd = static_cast<const char *>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        func(QByteArrayView{begin, lineEnd - begin});
+        begin = lineEnd + 1;
+    }
+}
+
+// the mapping is released with file
+template <typename Func>
+bool withMappedFile(const QString &path, Func &&func)
+{
+    QFile file{path};
+    if (!file.open(QFile::ReadOnly | QFile::ExistingOnly)) {
+        return false;
+    }
+
+    if (file.size() == 0) {
+        func(QByteArrayView{});
+        return true;
+    }
+
+    const auto *data = file.map(0, file.size());
+    if (data == nullptr) {
+        return false;
+    }
+
+    func(QByteArrayView{reinterpret_cast<const char *>(data), file.size()});
+    return true;
+}
+
+QString desktopIdOf(const QString &path)
+{
+    auto index = path.lastIndexOf(QLatin1StringView{ApplicationsDir.data(), ApplicationsDir.size()});
+    if (index == -1) {
+        return {};
+    }
+
+    auto id = path.sliced(index + ApplicationsDir.size());
+    id.chop(DesktopSuffix.size());
+    id.replace(u'/', u'-');
+    return id;
+}
+}  // namespace
+
+PackageIndex &PackageIndex::instance()
+{
+    static PackageIndex index;
+    return index;
+}
+
+QHash<QString, QString> PackageIndex::parseStatus(QByteArrayView content) noexcept
+{
+    QHash<QString, QString> versions;
+    QByteArrayView package;
+    QByteArrayView version;
+    bool installed{false};
+
+    auto flush = [&]() {
+        if (installed && !package.isEmpty()) {
+            versions.insert(QString::fromUtf8(package), QString::fromUtf8(version));
+        }
+        package = {};
+        version = {};
+        installed = false;
+    };
+
+    forEachLine(content, [&](QByteArrayView line) {
+        if (line.isEmpty()) {
+            flush();
+        } else if (line.startsWith("Package: ")) {
+            package = line.sliced(9);
+        } else if (line.startsWith("Version: ")) {
+            version = line.sliced(9);
+        } else if (line.startsWith("Status: ")) {
+            installed = line.endsWith(" installed");
+        }
+    });
+    flush();
+
+    return versions;
+}
+
+QStringList PackageIndex::parseDesktopFiles(QByteArrayView content) noexcept
+{
+    QStringList files;
+    forEachLine(content, [&files](QByteArrayView line) {
+        if (line.endsWith(DesktopSuffix) && line.indexOf(ApplicationsDir) != -1) {
+            files.append(QString::fromUtf8(line));
+        }
+    });
+    return files;
+}
+
+std::shared_ptr<const PackageIndex::Snapshot> PackageIndex::build(const std::shared_ptr<const Snapshot> &previous,
+                                                    const QString &dpkgDir) noexcept
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    const QDir dir{dpkgDir};
+
+    const QFileInfo status{dir.filePath(u"status"_s)};
+    snapshot->statusMtime = status.lastModified().toMSecsSinceEpoch();
+    snapshot->statusSize = status.exists() ? status.size() : -1;
+    if (previous && previous->statusMtime == snapshot->statusMtime && previous->statusSize == snapshot->statusSize) {
+        snapshot->versions = previous->versions;
+    } else {
+        withMappedFile(status.absoluteFilePath(), [&snapshot](QByteArrayView content) {
+            snapshot->versions = parseStatus(content);
+        });
+    }
+
+    const auto lists = QDir{dir.filePath(u"info"_s)}.entryInfoList({u"*.list"_s}, QDir::Files);
+    qsizetype parsed{0};
+    for (const auto &info : lists) {
+        const auto name = info.fileName();
+        const auto mtime = info.lastModified().toMSecsSinceEpoch();
+        if (previous) {
+            if (auto old = previous->lists.constFind(name);
+                old != previous->lists.cend() && old->mtime == mtime && old->size == info.size()) {
+                snapshot->lists.insert(name, old.value());
+                continue;
+            }
+        }
+
+        // multiarch packages are listed as <package>:<arch>.list
+        auto package = info.completeBaseName();
+        if (auto colon = package.indexOf(u':'); colon != -1) {
+            package.truncate(colon);
+        }
+
+        ListEntry entry{std::move(package), mtime, info.size(), {}};
+        withMappedFile(info.absoluteFilePath(), [&entry](QByteArrayView content) {
+            entry.desktopFiles = parseDesktopFiles(content);
+        });
+        snapshot->lists.insert(name, std::move(entry));
+        ++parsed;
+    }
+
+    for (const auto &entry : std::as_const(snapshot->lists)) {
+        if (!snapshot->versions.contains(entry.package)) {
+            continue;
+        }
+
+        for (const auto &file : entry.desktopFiles) {
+            snapshot->desktopFiles.insert(file, entry.package);
+            snapshot->desktopIds.insert(desktopIdOf(file), entry.package);
+        }
+    }
+
+    qCInfo(amPackageIndex) << "package index built," << snapshot->versions.size() << "packages," << parsed << "of"
+                           << lists.size() << "lists parsed.";
+    return snapshot;
+}
+
+void PackageIndex::refresh() noexcept
+{
+    if (m_building) {
+        m_pending = true;
+        return;
+    }
+
+    m_building = true;
+    QtConcurrent::run([previous = m_snapshot]() { return build(previous, QString::fromLatin1(DpkgDir)); })
+        .then(this, [this](std::shared_ptr<const Snapshot> snapshot) {
+            m_snapshot = std::move(snapshot);
+            m_building = false;
+            if (std::exchange(m_pending, false)) {
+                refresh();
+            }
+        });
+}
+
+std::optional<PackageInfo> PackageIndex::packageInfo(const QString &package) const noexcept
+{
+    auto version = m_snapshot->versions.constFind(package);
+    if (version == m_snapshot->versions.cend()) {
+        return std::nullopt;
+    }
+
+    return PackageInfo{package, version.value()};
+}
+
+std::optional<PackageInfo> PackageIndex::findByDesktopFile(const QString &path) const noexcept
+{
+    if (!m_snapshot) {
+        return std::nullopt;
+    }
+
+    auto package = m_snapshot->desktopFiles.constFind(path);
+    return package == m_snapshot->desktopFiles.cend() ? std::nullopt : packageInfo(package.value());
+}
+
+std::optional<PackageInfo> PackageIndex::findByDesktopId(const QString &desktopId) const noexcept
+{
+    if (!m_snapshot) {
+        return std::nullopt;
+    }
+
+    auto package = m_snapshot->desktopIds.constFind(desktopId);
+    return package == m_snapshot->desktopIds.cend() ? std::nullopt : packageInfo(package.value());
+}
+
+std::optional<PackageInfo> PackageIndex::findByPackage(const QString &package) const noexcept
+{
+    return m_snapshot ? packageInfo(package) : std::nullopt;
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef PACKAGEINDEX_H
+#define PACKAGEINDEX_H
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <optional>
+
+struct PackageInfo
+{
+    QString name;
+    QString version;
+};
+
+// Maps desktop files installed by dpkg to their package.
+// It's built from /var/lib/dpkg on a worker thread, lookups only read the in-memory snapshot.
+class PackageIndex : public QObject
+{
+    Q_OBJECT
+public:
+    struct ListEntry
+    {
+        QString package;
+        qint64 mtime{0};
+        qint64 size{0};
+        QStringList desktopFiles;
+    };
+
+    struct Snapshot
+    {
+        QHash<QString, QString> versions;      // installed package -> version
+        qint64 statusMtime{0};                 // of the status file versions were parsed from
+        qint64 statusSize{-1};
+        QHash<QString, ListEntry> lists;       // name of info/*.list -> desktop files in it
+        QHash<QString, QString> desktopFiles;  // desktop file path -> package
+        QHash<QString, QString> desktopIds;    // desktop id -> package
+    };
+
+    static PackageIndex &instance();
+
+    // rebuilds the index in background, the status and list files whose mtime and size are unchanged are reused
+    void refresh() noexcept;
+    [[nodiscard]] bool isReady() const noexcept { return static_cast<bool>(m_snapshot); }
+
+    [[nodiscard]] std::optional<PackageInfo> findByDesktopFile(const QString &path) const noexcept;
+    [[nodiscard]] std::optional<PackageInfo> findByDesktopId(const QString &desktopId) const noexcept;
+    [[nodiscard]] std::optional<PackageInfo> findByPackage(const QString &package) const noexcept;
+
+    [[nodiscard]] static std::shared_ptr<const Snapshot> build(const std::shared_ptr<const Snapshot> &previous,
+                                                               const QString &dpkgDir) noexcept;
+    [[nodiscard]] static QHash<QString, QString> parseStatus(QByteArrayView content) noexcept;
+    [[nodiscard]] static QStringList parseDesktopFiles(QByteArrayView content) noexcept;
+
+private:
+    PackageIndex() = default;
+
+    [[nodiscard]] std::optional<PackageInfo> packageInfo(const QString &package) const noexcept;
+
+    std::shared_ptr<const Snapshot> m_snapshot;
+    bool m_building{false};
+    bool m_pending{false};
+};
+
+#endif
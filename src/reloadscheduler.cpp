@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "reloadscheduler.h"
+#include <algorithm>
+
+qint64 ReloadScheduler::addChange(qint64 now, bool transactionRunning) noexcept
+{
+    ++m_changes;
+    if (m_lastChange >= 0 && now - m_lastChange < m_policy.burstGap) {
+        m_window = std::min(std::max(m_window, m_policy.initialDelay) * 2, m_policy.maxDelay);
+    } else {
+        m_window = m_policy.initialDelay;
+    }
+
+    m_lastChange = now;
+    if (m_pendingSince < 0) {
+        m_pendingSince = now;
+    }
+    m_pendingOutsideTransaction = m_pendingOutsideTransaction || !transactionRunning;
+
+    return remaining(now, transactionRunning);
+}
+
+qint64 ReloadScheduler::remaining(qint64 now, bool transactionRunning) const noexcept
+{
+    if (!hasPending()) {
+        return 0;
+    }
+
+    if (transactionRunning) {
+        // look again every maxDelay, the end of transaction is usually announced by a change event as well
+        const auto due = std::min(m_pendingSince + m_policy.maxHold, now + m_policy.maxDelay);
+        return std::max<qint64>(due - now, 0);
+    }
+
+    const auto due = std::min(m_lastChange + m_window, m_pendingSince + m_policy.maxStaleness);
+    return std::max<qint64>(due - now, 0);
+}
+
+void ReloadScheduler::reloaded() noexcept
+{
+    if (!hasPending()) {
+        return;
+    }
+
+    ++m_reloads;
+    clearPending();
+}
+
+bool ReloadScheduler::coverTransaction() noexcept
+{
+    if (!hasPending() || m_pendingOutsideTransaction) {
+        return false;
+    }
+
+    clearPending();
+    return true;
+}
+
+void ReloadScheduler::clearPending() noexcept
+{
+    m_pendingSince = -1;
+    m_pendingOutsideTransaction = false;
+}
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef RELOADSCHEDULER_H
+#define RELOADSCHEDULER_H
+
+#include <QtGlobal>
+
+// Decides when change events of application directories turn into a reload.
+// An isolated change is picked up after a short delay, the window doubles while changes keep coming
+// and a pending change is never delayed beyond maxStaleness. While a package transaction is running
+// reloads are held until it ends, bounded by maxHold in case the end of transaction is never announced.
+// Times are msecs of a monotonic clock.
+class ReloadScheduler
+{
+public:
+    struct Policy
+    {
+        qint64 initialDelay{200};
+        qint64 maxDelay{5000};
+        qint64 burstGap{2000};  // changes closer than it belong to the same burst
+        qint64 maxStaleness{30000};
+        qint64 maxHold{600000};
+    };
+
+    ReloadScheduler() noexcept = default;
+    explicit ReloadScheduler(Policy policy) noexcept
+        : m_policy(policy)
+    {
+    }
+
+    // returns msecs from now until the reload is due
+    [[nodiscard]] qint64 addChange(qint64 now, bool transactionRunning) noexcept;
+    // returns 0 if the pending changes should be reloaded now, otherwise msecs to wait
+    [[nodiscard]] qint64 remaining(qint64 now, bool transactionRunning) const noexcept;
+    // a reload has consumed all pending changes
+    void reloaded() noexcept;
+    // the package manager reported what its transaction changed, pending changes are consumed
+    // if all of them were seen while a transaction was running; returns whether they were.
+    // Consumed changes don't count as a reload.
+    bool coverTransaction() noexcept;
+
+    [[nodiscard]] bool hasPending() const noexcept { return m_pendingSince >= 0; }
+    [[nodiscard]] quint64 changes() const noexcept { return m_changes; }
+    [[nodiscard]] quint64 reloads() const noexcept { return m_reloads; }
+    // changes which didn't cost a reload of their own
+    [[nodiscard]] quint64 savedReloads() const noexcept { return m_changes - m_reloads; }
+
+private:
+    void clearPending() noexcept;
+
+    Policy m_policy;
+    qint64 m_pendingSince{-1};
+    qint64 m_lastChange{-1};
+    qint64 m_window{0};
+    bool m_pendingOutsideTransaction{false};
+    quint64 m_changes{0};
+    quint64 m_reloads{0};
+};
+
+#endif
@@ -7,12 +7,36 @@
 #include "global.h"
 #include "sessiontype.h"
 
+#include <QDir>
+#include <QFileInfo>
 #include <QLoggingCategory>
 
 using namespace Qt::StringLiterals;
 
 Q_LOGGING_CATEGORY(logSessionOverride, "dde.am.session.override")
 
+namespace {
+constexpr auto &AppOverrideConfigName = u"org.deepin.dde.am.appoverride";
+
+bool hasOverrideFiles(const QDir &dir)
+{
+    return !dir.entryList({u"*.json"_s}, QDir::Files).isEmpty();
+}
+
+// a directory which doesn't exist can't be watched, its creation shows up in the nearest existing ancestor
+QString nearestExistingDir(QString path)
+{
+    while (!QFileInfo{path}.isDir()) {
+        auto parent = QFileInfo{path}.path();
+        if (parent == path) {
+            return {};
+        }
+        path = std::move(parent);
+    }
+    return path;
+}
+}  // namespace
+
 SessionOverrideConfig::SessionOverrideConfig(QObject *parent)
     : QObject(parent)
 {
@@ -29,12 +53,162 @@ SessionOverrideConfig::SessionOverrideConfig(QObject *parent)
         break;
     }
     qCInfo(logSessionOverride) << "Session override config initialized for" << m_subpathPrefix;
+
+    if (m_subpathPrefix.isEmpty()) {
+        return;
+    }
+
+    m_overrideRoots = defaultOverrideRoots();
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &path) {
+        qCInfo(logSessionOverride) << "Override directory changed:" << path;
+        const auto old = m_discovered;
+        rediscover();
+        if (old == m_discovered) {
+            return;
+        }
+
+        if (!old || !m_discovered) {
+            emit configChanged();
+            return;
+        }
+
+        // applications which gained or lost their overrides
+        auto changed = *old;
+        changed.unite(*m_discovered).subtract(QSet<QString>{*old}.intersect(*m_discovered));
+        for (const auto &id : std::as_const(changed)) {
+            ensureLoaded(id);
+        }
+        emit overridesChanged(changed.values());
+    });
+    rediscover();
+}
+
+QStringList SessionOverrideConfig::defaultOverrideRoots()
+{
+    QStringList roots;
+    for (const auto &dir : getXDGDataDirs()) {
+        roots.append(dir + u"/dsg/configs/overrides"_s);
+    }
+    roots.append(u"/etc/dsg/configs/overrides"_s);
+    return roots;
+}
+
+std::optional<QSet<QString>> SessionOverrideConfig::discoverOverrides(const QStringList &roots, QStringView sessionDir)
+{
+    // DConfig looks for overrides in <root>/[<appid>/]<config name>/<subpath>, our subpath is /<desktop id>/<session>.
+    QSet<QString> ret;
+    const auto configName = fromStaticRaw(AppOverrideConfigName);
+    for (const auto &root : roots) {
+        const QDir rootDir{root};
+        for (const auto &configDir : {rootDir.filePath(fromStaticRaw(ApplicationServiceID) + u'/' + configName),
+                                      rootDir.filePath(configName)}) {
+            const QDir dir{configDir};
+            if (!dir.exists()) {
+                continue;
+            }
+
+            if (hasOverrideFiles(dir)) {
+                return std::nullopt;
+            }
+
+            const auto desktopIds = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+            for (const auto &desktopId : desktopIds) {
+                const QDir appDir{dir.filePath(desktopId)};
+                if (hasOverrideFiles(appDir) || hasOverrideFiles(QDir{appDir.filePath(sessionDir.toString())})) {
+                    ret.insert(desktopId);
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+QStringList SessionOverrideConfig::overrideWatchDirs(const QStringList &roots, QStringView sessionDir)
+{
+    QStringList ret;
+    const auto configName = fromStaticRaw(AppOverrideConfigName);
+    for (const auto &root : roots) {
+        const QDir rootDir{root};
+        for (const auto &configDir : {rootDir.filePath(fromStaticRaw(ApplicationServiceID) + u'/' + configName),
+                                      rootDir.filePath(configName)}) {
+            const QDir dir{configDir};
+            if (!dir.exists()) {
+                if (auto ancestor = nearestExistingDir(configDir); !ancestor.isEmpty()) {
+                    ret.append(std::move(ancestor));
+                }
+                continue;
+            }
+            ret.append(configDir);
+
+            // override files may be added to directories which already exist
+            const auto desktopIds = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+            for (const auto &desktopId : desktopIds) {
+                const QDir appDir{dir.filePath(desktopId)};
+                ret.append(appDir.path());
+                if (const auto session = appDir.filePath(sessionDir.toString()); QDir{session}.exists()) {
+                    ret.append(session);
+                }
+            }
+        }
+    }
+
+    ret.removeDuplicates();
+    return ret;
+}
+
+void SessionOverrideConfig::rediscover()
+{
+    if (auto dirs = m_watcher.directories(); !dirs.isEmpty()) {
+        m_watcher.removePaths(dirs);
+    }
+
+    const auto sessionDir = QStringView{m_subpathPrefix}.sliced(1);
+    if (auto dirs = overrideWatchDirs(m_overrideRoots, sessionDir); !dirs.isEmpty()) {
+        m_watcher.addPaths(dirs);
+    }
+
+    m_discovered = discoverOverrides(m_overrideRoots, sessionDir);
+    if (!m_discovered) {
+        qCInfo(logSessionOverride) << "Global override found, every application may be overridden.";
+        return;
+    }
+
+    qCInfo(logSessionOverride) << m_discovered->size() << "applications have session overrides.";
+
+    // drop configs of applications whose overrides are gone
+    for (auto it = m_configs.begin(); it != m_configs.end();) {
+        if (m_discovered->contains(it->first)) {
+            ++it;
+            continue;
+        }
+
+        m_overrides.remove(it->first);
+        m_loaded.remove(it->first);
+        it = m_configs.erase(it);
+    }
+}
+
+bool SessionOverrideConfig::mayHaveOverride(const QString &desktopId) const
+{
+    return !m_subpathPrefix.isEmpty() && (!m_discovered || m_discovered->contains(desktopId));
 }
 
 SessionOverrideConfig::~SessionOverrideConfig() = default;
 
 void SessionOverrideConfig::preload(const QStringList &desktopIds)
 {
+    if (m_discovered) {
+        // cost scales with the number of overrides instead of the number of applications
+        const QSet<QString> ids{desktopIds.cbegin(), desktopIds.cend()};
+        for (const auto &id : std::as_const(*m_discovered)) {
+            if (ids.contains(id)) {
+                ensureLoaded(id);
+            }
+        }
+        return;
+    }
+
     for (const auto &id : desktopIds) {
         ensureLoaded(id);
     }
@@ -42,7 +216,7 @@ void SessionOverrideConfig::preload(const QStringList &desktopIds)
 
 void SessionOverrideConfig::ensureLoaded(const QString &desktopId) const
 {
-    if (m_loaded.contains(desktopId))
+    if (m_loaded.contains(desktopId) || !mayHaveOverride(desktopId))
         return;
     m_loaded.insert(desktopId);
 
@@ -81,7 +255,7 @@ void SessionOverrideConfig::updateOverride(const QString &desktopId) const
 
 ApplicationOverrideConfig *SessionOverrideConfig::configFor(const QString &desktopId) const
 {
-    if (m_subpathPrefix.isEmpty())
+    if (!mayHaveOverride(desktopId))
         return nullptr;
 
     auto it = m_configs.find(desktopId);
@@ -106,7 +280,7 @@ ApplicationOverrideConfig *SessionOverrideConfig::configFor(const QString &deskt
             qCInfo(logSessionOverride) << "Override changed for" << desktopId << "key:" << key;
             self->updateOverride(desktopId);
             emit self->overrideChanged(desktopId, key);
-            emit self->configChanged();
+            emit self->overridesChanged({desktopId});
         }
     });
 
@@ -119,6 +293,8 @@ ApplicationOverrideConfig *SessionOverrideConfig::configFor(const QString &deskt
                                    << "Icon:" << config->Icon()
                                    << "TryExec:" << config->TryExec()
                                    << "hasOverride:" << self->hasOverride(desktopId);
+        // values read before initialization finished may be stale
+        emit self->overridesChanged({desktopId});
     });
 
     QObject::connect(config, &ApplicationOverrideConfig::configInitializeFailed,
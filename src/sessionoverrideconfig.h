@@ -6,6 +6,7 @@
 #define SESSIONOVERRIDECONFIG_H
 
 #include <QObject>
+#include <QFileSystemWatcher>
 #include <QHash>
 #include <QString>
 #include <QStringList>
@@ -30,12 +31,25 @@ public:
 
     static QString resolveExecValue(const QString &overrideValue, QStringView originalExec);
 
+    // Lists desktop ids which have override files for sessionDir ("wayland" or "x11") under roots.
+    // Returns std::nullopt if an override applies to every application.
+    static std::optional<QSet<QString>> discoverOverrides(const QStringList &roots, QStringView sessionDir);
+    // Directories whose changes may add or remove overrides: the config directories (or the nearest existing
+    // ancestors of missing ones), the <desktop id> directories in them and their sessionDir subdirectories.
+    static QStringList overrideWatchDirs(const QStringList &roots, QStringView sessionDir);
+    static QStringList defaultOverrideRoots();
+
 signals:
+    // overrides of every application may be changed
     void configChanged();
+    // only overrides of these applications are changed
+    void overridesChanged(const QStringList &desktopIds);
     void overrideChanged(const QString &desktopId, const QString &key);
 
 private:
     Q_DISABLE_COPY(SessionOverrideConfig)
+    void rediscover();
+    [[nodiscard]] bool mayHaveOverride(const QString &desktopId) const;
     void ensureLoaded(const QString &desktopId) const;
     void updateOverride(const QString &desktopId) const;
     ApplicationOverrideConfig *configFor(const QString &desktopId) const;
@@ -45,6 +59,9 @@ private:
     mutable QSet<QString> m_loaded;
     SessionType m_sessionType;
     QString m_subpathPrefix;
+    QStringList m_overrideRoots;
+    std::optional<QSet<QString>> m_discovered;  // std::nullopt means every application may be overridden
+    QFileSystemWatcher m_watcher;
 };
 
 #endif
\ No newline at end of file
@@ -40,6 +40,22 @@ bool SystemdSignalDispatcher::connectToSignals() noexcept
         return false;
     }
 
+    // units signal their own PropertiesChanged, QtDBus can't match a path namespace, so the rules are
+    // filtered by arg0 on the interfaces only unit objects implement and the path is checked in the slot
+    for (const auto &interface : {fromStaticRaw(SystemdServiceInterfaceName), fromStaticRaw(SystemdScopeInterfaceName)}) {
+        if (!con.connect(SystemdService,
+                         {},
+                         fromStaticRaw(SystemdPropInterfaceName),
+                         u"PropertiesChanged"_s,
+                         QStringList{interface},
+                         {},
+                         this,
+                         SLOT(onUnitPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)))) {
+            qCritical() << "can't connect to PropertiesChanged signal of systemd units.";
+            return false;
+        }
+    }
+
     if (!con.connect(SystemdService,
                      SystemdObjectPath,
                      SystemdInterfaceName,
@@ -67,6 +83,29 @@ void SystemdSignalDispatcher::onPropertiesChanged(const QString &interface,
     }
 }
 
+void SystemdSignalDispatcher::onUnitPropertiesChanged(const QString &interface,
+                                                      const QVariantMap &props,
+                                                      [[maybe_unused]] const QStringList &invalid,
+                                                      const QDBusMessage &message)
+{
+    if (!message.path().startsWith(fromStaticRaw(SystemdUnitPathNamespace))) {
+        return;
+    }
+
+    // Result is a property of services and scopes
+    if (interface != fromStaticRaw(SystemdServiceInterfaceName) && interface != fromStaticRaw(SystemdScopeInterfaceName)) {
+        return;
+    }
+
+    using namespace Qt::StringLiterals;
+    if (auto it = props.constFind(u"Result"_s); it != props.cend()) {
+        auto result = it->toString();
+        if (!result.isEmpty() && result != u"success"_s) {
+            emit SystemdUnitResultChanged(QDBusObjectPath{message.path()}, result);
+        }
+    }
+}
+
 void SystemdSignalDispatcher::onUnitNew(const QString &unitName, const QDBusObjectPath &systemdUnitPath)
 {
     emit SystemdUnitNew(unitName, systemdUnitPath);
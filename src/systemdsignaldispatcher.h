@@ -22,12 +22,17 @@ Q_SIGNALS:
     void SystemdJobNew(const QString &unitName, const QDBusObjectPath &systemdUnitPath);
     void SystemdUnitRemoved(const QString &unitName, const QDBusObjectPath &systemdUnitPath);
     void SystemdEnvironmentChanged(const QStringList &envs);
+    void SystemdUnitResultChanged(const QDBusObjectPath &systemdUnitPath, const QString &result);
 
 private Q_SLOTS:
     void onUnitNew(const QString &unitName, const QDBusObjectPath &systemdUnitPath);
     void onJobNew(uint32_t id, const QDBusObjectPath &systemdUnitPath, const QString &unitName);
     void onUnitRemoved(const QString &unitName, const QDBusObjectPath &systemdUnitPath);
     void onPropertiesChanged(const QString &interface, const QVariantMap &props, const QStringList &invalid);
+    void onUnitPropertiesChanged(const QString &interface,
+                                 const QVariantMap &props,
+                                 const QStringList &invalid,
+                                 const QDBusMessage &message);
 
 private:
     explicit SystemdSignalDispatcher(QObject *parent = nullptr)
@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include <QCoreApplication>
 #include <QDBusMetaType>
+#include <QFile>
+#include <QTemporaryDir>
 #include <QTimer>
 
 namespace {
@@ -24,6 +26,12 @@ void registerComplexDbusType()  // FIXME: test shouldn't associate with DBus
 
 int main(int argc, char **argv)
 {
+    // caches written by tests (e.g. mime cache sidecars) mustn't touch the user's cache directory
+    QTemporaryDir cacheHome;
+    if (!cacheHome.isValid() || !qputenv("XDG_CACHE_HOME", QFile::encodeName(cacheHome.path()))) {
+        return 1;
+    }
+
     QCoreApplication app(argc, argv);
 
     registerComplexDbusType();
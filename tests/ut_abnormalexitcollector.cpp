@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "abnormalexitcollector.h"
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestAbnormalExitCollector, rateLimitPerApp)
+{
+    auto &collector = AbnormalExitCollector::instance();
+    constexpr qint64 now = 1'000'000'000;
+    for (int i = 0; i < AbnormalExitCollector::kMaxReportsPerWindow; ++i) {
+        EXPECT_TRUE(collector.acquire(u"rate-limit-test"_s, now + i));
+    }
+    EXPECT_FALSE(collector.acquire(u"rate-limit-test"_s, now + 1000));
+    EXPECT_TRUE(collector.acquire(u"rate-limit-other"_s, now + 1000));
+
+    // a new window starts after the old one expired
+    EXPECT_TRUE(collector.acquire(u"rate-limit-test"_s, now + AbnormalExitCollector::kRateWindowMs));
+}
+
+TEST(TestAbnormalExitCollector, readMissingUnit)
+{
+    EXPECT_TRUE(AbnormalExitCollector::readUnitJournal(u"app-DDE-not-exist@0.service"_s, 6, 1000).isEmpty());
+}
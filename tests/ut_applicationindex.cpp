@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationindex.h"
+#include "applicationindexwriter.h"
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+QList<ApplicationIndexEntry> sampleEntries()
+{
+    ApplicationIndexEntry editor;
+    editor.id = u"org.example.editor"_s;
+    editor.objectPath = u"/org/desktopspec/ApplicationManager1/org_2eexample_2eeditor"_s;
+    editor.name = u"文本编辑器"_s;
+    editor.icon = u"accessories-text-editor"_s;
+    editor.categories = {u"Utility"_s, u"TextEditor"_s};
+    editor.startupWMClass = u"editor"_s;
+
+    ApplicationIndexEntry daemon;
+    daemon.id = u"org.example.daemon"_s;
+    daemon.objectPath = u"/org/desktopspec/ApplicationManager1/org_2eexample_2edaemon"_s;
+    daemon.name = u"Daemon"_s;
+    daemon.noDisplay = true;
+
+    return {editor, daemon};
+}
+}  // namespace
+
+TEST(ApplicationIndexTest, roundTrip)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath(u"index"_s);
+    ASSERT_TRUE(ApplicationIndexWriter::publish(path, sampleEntries(), 42));
+
+    ApplicationIndexReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.generation(), 42U);
+    EXPECT_TRUE(reader.isLive());
+    EXPECT_EQ(reader.size(), 2);
+    EXPECT_EQ(reader.ids(), (QStringList{u"org.example.daemon"_s, u"org.example.editor"_s}));
+
+    auto editor = reader.find(u"org.example.editor"_s);
+    ASSERT_TRUE(editor.has_value());
+    EXPECT_EQ(editor->name, u"文本编辑器"_s);
+    EXPECT_EQ(editor->icon, u"accessories-text-editor"_s);
+    EXPECT_EQ(editor->categories, (QStringList{u"Utility"_s, u"TextEditor"_s}));
+    EXPECT_EQ(editor->startupWMClass, u"editor"_s);
+    EXPECT_FALSE(editor->noDisplay);
+
+    auto daemon = reader.find(u"org.example.daemon"_s);
+    ASSERT_TRUE(daemon.has_value());
+    EXPECT_TRUE(daemon->noDisplay);
+    EXPECT_TRUE(daemon->categories.isEmpty());
+
+    EXPECT_FALSE(reader.find(u"org.example"_s).has_value());
+    EXPECT_FALSE(reader.find(u"org.example.editorx"_s).has_value());
+}
+
+TEST(ApplicationIndexTest, replacedIndexKeepsOldMapping)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath(u"index"_s);
+    ASSERT_TRUE(ApplicationIndexWriter::publish(path, sampleEntries(), 1));
+
+    ApplicationIndexReader oldReader;
+    ASSERT_TRUE(oldReader.open(path));
+
+    ASSERT_TRUE(ApplicationIndexWriter::publish(path, {}, 2));
+    EXPECT_EQ(oldReader.generation(), 1U);
+    EXPECT_EQ(oldReader.size(), 2);
+
+    ApplicationIndexReader newReader;
+    ASSERT_TRUE(newReader.open(path));
+    EXPECT_EQ(newReader.generation(), 2U);
+    EXPECT_EQ(newReader.size(), 0);
+}
+
+TEST(ApplicationIndexTest, rejectBrokenIndex)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath(u"index"_s);
+
+    auto content = ApplicationIndexWriter::serialize(sampleEntries(), 1);
+    content.truncate(content.size() - 4);
+    QFile file{path};
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.write(content);
+    file.close();
+
+    ApplicationIndexReader reader;
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.open(dir.filePath(u"missing"_s)));
+}
+
+TEST(ApplicationIndexTest, rejectIndexOfExitedDaemon)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath(u"index"_s);
+
+    // same pid reused by another process after the publisher exited
+    auto content = ApplicationIndexWriter::serialize(sampleEntries(), 1);
+    reinterpret_cast<ApplicationIndexHeader *>(content.data())->owner.startTime += 1;
+    QFile file{path};
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.write(content);
+    file.close();
+
+    ApplicationIndexReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.size(), 2);
+    EXPECT_FALSE(reader.isLive());
+}
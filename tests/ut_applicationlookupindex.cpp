@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationlookupindex.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+class TestApplicationLookupIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_index.update(u"firefox"_s,
+                       LookupKeys{u"Firefox"_s, {u"/usr/lib/firefox/firefox"_s}, {u"Network"_s, u"WebBrowser"_s}});
+        m_index.update(u"chromium"_s, LookupKeys{u"chromium"_s, {u"/usr/bin/chromium"_s}, {u"Network"_s, u"WebBrowser"_s}});
+        m_index.update(u"editor"_s, LookupKeys{{}, {u"/usr/bin/editor"_s}, {u"Utility"_s}});
+    }
+
+    ApplicationLookupIndex m_index;
+};
+
+TEST_F(TestApplicationLookupIndex, lookup)
+{
+    EXPECT_EQ(m_index.findByWMClass(u"firefox"_s), QStringList{u"firefox"_s});
+    EXPECT_EQ(m_index.findByWMClass(u"CHROMIUM"_s), QStringList{u"chromium"_s});
+    EXPECT_TRUE(m_index.findByWMClass(QString{}).isEmpty());
+    EXPECT_EQ(m_index.findByExecutable(u"/usr/bin/chromium"_s), QStringList{u"chromium"_s});
+    EXPECT_EQ(m_index.listByCategory(u"WebBrowser"_s), (QStringList{u"chromium"_s, u"firefox"_s}));
+    EXPECT_TRUE(m_index.listByCategory(u"webbrowser"_s).isEmpty());
+}
+
+TEST_F(TestApplicationLookupIndex, incrementalUpdate)
+{
+    m_index.update(u"firefox"_s, LookupKeys{u"firefox-esr"_s, {u"/usr/lib/firefox-esr/firefox-esr"_s}, {u"Network"_s}});
+    EXPECT_TRUE(m_index.findByWMClass(u"Firefox"_s).isEmpty());
+    EXPECT_EQ(m_index.findByWMClass(u"firefox-esr"_s), QStringList{u"firefox"_s});
+    EXPECT_EQ(m_index.listByCategory(u"WebBrowser"_s), QStringList{u"chromium"_s});
+
+    m_index.remove(u"chromium"_s);
+    EXPECT_TRUE(m_index.listByCategory(u"WebBrowser"_s).isEmpty());
+    EXPECT_TRUE(m_index.findByExecutable(u"/usr/bin/chromium"_s).isEmpty());
+    EXPECT_EQ(m_index.size(), 2);
+}
+
+TEST_F(TestApplicationLookupIndex, resolveExecutable)
+{
+    EXPECT_EQ(ApplicationLookupIndex::programOf({u"env"_s, u"LANG=C"_s, u"-u"_s, u"/usr/bin/foo"_s, u"%U"_s}), u"/usr/bin/foo"_s);
+    EXPECT_EQ(ApplicationLookupIndex::programOf({u"foo"_s, u"--bar"_s}), u"foo"_s);
+    EXPECT_TRUE(ApplicationLookupIndex::programOf({}).isEmpty());
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto target = dir.filePath(u"real-program"_s);
+    QFile file{target};
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.close();
+    ASSERT_TRUE(file.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner));
+    ASSERT_TRUE(QFile::link(target, dir.filePath(u"program"_s)));
+
+    const auto resolved = ApplicationLookupIndex::resolveExecutable(u"program"_s, {dir.path()});
+    ASSERT_EQ(resolved.size(), 2);
+    EXPECT_EQ(resolved.first(), dir.filePath(u"program"_s));
+
+    m_index.update(u"program"_s, LookupKeys{{}, resolved, {}});
+    EXPECT_EQ(m_index.findByExecutable(target), QStringList{u"program"_s});
+    EXPECT_TRUE(ApplicationLookupIndex::resolveExecutable(u"not-exist-program"_s, {dir.path()}).isEmpty());
+}
@@ -37,6 +37,7 @@ public:
         QSharedPointer<InstanceService> instance = QSharedPointer<InstanceService>::create(
             InstancePath.path().split('/').last(), ApplicationPath.path(), QString{"/"}, QString{"DDE"});
         app->m_Instances.insert(InstancePath, instance);
+        InstanceIndex::instance().insert(appID, InstancePath, instance);
         m_am->m_applicationList.insert(appID, app);
         new InstanceAdaptor{instance.data()};
     }
@@ -162,6 +163,14 @@ TEST_F(TestApplicationManager, identifyService)
 
     EXPECT_EQ(instanceInfo, map);
 
+    const auto results = m_am->IdentifyMany({QDBusUnixFileDescriptor{pidfd}, QDBusUnixFileDescriptor{}});
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results.first().applicationId.toStdString(), QString{"test-Application"}.toStdString());
+    EXPECT_EQ(results.first().instance, path);
+    EXPECT_TRUE(results.first().error.isEmpty());
+    EXPECT_TRUE(results.last().applicationId.isEmpty());
+    EXPECT_FALSE(results.last().error.isEmpty());
+
     close(pidfd);
 
     if (pidFile.exists()) {
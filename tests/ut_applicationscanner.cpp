@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationscanner.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+bool writeDesktopFile(const QString &path, const QString &name)
+{
+    QFile file{path};
+    const auto content = u"[Desktop Entry]\nType=Application\nName=%1\nExec=/usr/bin/true\n"_s.arg(name).toUtf8();
+    return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(content) == content.size();
+}
+
+ApplicationSnapshot snapshotOf(const QStringList &dirs)
+{
+    ApplicationSnapshot snapshot;
+    forEachApplicationDesktopFile(dirs, [&snapshot](DesktopFile file) -> bool {
+        DesktopEntry entry;
+        if (entry.parse(file) == ParserError::NoError) {
+            snapshot.insert(file.desktopId(),
+                            ApplicationSnapshotEntry{file.sourcePath(), file.modifiedTime(), file.createTime(), std::move(entry)});
+        }
+        return false;
+    });
+    return snapshot;
+}
+
+QStringList idsOf(const std::vector<ApplicationDelta::Entry> &entries)
+{
+    QStringList ret;
+    for (const auto &entry : entries) {
+        ret.append(entry.file.desktopId());
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+}  // namespace
+
+TEST(ApplicationScanner, diffAgainstSnapshot)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDir root{dir.path()};
+    ASSERT_TRUE(root.mkpath(u"sub"_s));
+    for (const auto &name : {u"keep"_s, u"change"_s, u"touch"_s, u"remove"_s}) {
+        ASSERT_TRUE(writeDesktopFile(root.filePath(name + u".desktop"_s), name));
+    }
+    ASSERT_TRUE(writeDesktopFile(root.filePath(u"sub/nested.desktop"_s), u"nested"_s));
+
+    const QStringList dirs{dir.path()};
+    auto initial = scanApplicationChanges({}, dirs, nullptr);
+    ASSERT_NE(initial, nullptr);
+    EXPECT_EQ(idsOf(initial->added), (QStringList{u"change"_s, u"keep"_s, u"remove"_s, u"sub-nested"_s, u"touch"_s}));
+
+    const auto snapshot = snapshotOf(dirs);
+    ASSERT_EQ(snapshot.size(), 5);
+    EXPECT_TRUE(scanApplicationChanges(snapshot, dirs, nullptr)->isEmpty());
+
+    // times are compared in msecs, make sure they move
+    const auto later = QDateTime::currentDateTime().addSecs(10);
+    auto setModifiedTime = [&later](const QString &path) {
+        QFile file{path};
+        return file.open(QFile::ReadWrite) && file.setFileTime(later, QFileDevice::FileModificationTime);
+    };
+    ASSERT_TRUE(writeDesktopFile(root.filePath(u"change.desktop"_s), u"changed"_s));
+    ASSERT_TRUE(setModifiedTime(root.filePath(u"change.desktop"_s)));
+    ASSERT_TRUE(setModifiedTime(root.filePath(u"touch.desktop"_s)));
+    ASSERT_TRUE(QFile::remove(root.filePath(u"remove.desktop"_s)));
+    ASSERT_TRUE(writeDesktopFile(root.filePath(u"new.desktop"_s), u"new"_s));
+
+    auto delta = scanApplicationChanges(snapshot, dirs, nullptr);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(idsOf(delta->added), QStringList{u"new"_s});
+    EXPECT_EQ(idsOf(delta->changed), QStringList{u"change"_s});
+    ASSERT_EQ(delta->touched.size(), 1);
+    EXPECT_EQ(delta->touched.front().desktopId(), u"touch"_s);
+    EXPECT_EQ(delta->removed, QStringList{u"remove"_s});
+}
+
+TEST(ApplicationScanner, scanListedFiles)
+{
+    QTemporaryDir userDir;
+    QTemporaryDir systemDir;
+    ASSERT_TRUE(userDir.isValid() && systemDir.isValid());
+    const QDir user{userDir.path()};
+    const QDir system{systemDir.path()};
+    ASSERT_TRUE(system.mkpath(u"sub"_s));
+    for (const auto &name : {u"keep"_s, u"change"_s, u"remove"_s}) {
+        ASSERT_TRUE(writeDesktopFile(system.filePath(name + u".desktop"_s), name));
+    }
+    ASSERT_TRUE(writeDesktopFile(system.filePath(u"sub/nested.desktop"_s), u"nested"_s));
+
+    const QStringList dirs{userDir.path(), systemDir.path()};
+    auto snapshot = snapshotOf(dirs);
+    ASSERT_EQ(snapshot.size(), 4);
+
+    ASSERT_TRUE(writeDesktopFile(system.filePath(u"change.desktop"_s), u"changed"_s));
+    {
+        QFile file{system.filePath(u"change.desktop"_s)};
+        ASSERT_TRUE(file.open(QFile::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(QDateTime::currentDateTime().addSecs(10), QFileDevice::FileModificationTime));
+    }
+    ASSERT_TRUE(QFile::remove(system.filePath(u"remove.desktop"_s)));
+    ASSERT_TRUE(writeDesktopFile(system.filePath(u"new.desktop"_s), u"new"_s));
+    // shadowed by the user directory under another relative path
+    ASSERT_TRUE(writeDesktopFile(user.filePath(u"sub-nested.desktop"_s), u"nested"_s));
+
+    // only listed ids are looked at, keep isn't in the snapshot passed to the scanner
+    snapshot.remove(u"keep"_s);
+    const QStringList listed{u"change.desktop"_s, u"remove.desktop"_s, u"new.desktop"_s, u"sub/nested.desktop"_s};
+    auto delta = scanApplicationFiles(snapshot, listed, dirs, nullptr);
+    ASSERT_NE(delta, nullptr);
+    EXPECT_EQ(idsOf(delta->added), QStringList{u"new"_s});
+    EXPECT_EQ(idsOf(delta->changed), QStringList{u"change"_s});
+    ASSERT_EQ(delta->touched.size(), 1);
+    EXPECT_EQ(delta->touched.front().sourcePath(), user.filePath(u"sub-nested.desktop"_s));
+    EXPECT_EQ(delta->removed, QStringList{u"remove"_s});
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationsearchindex.h"
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+class TestApplicationSearchIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_index.update(u"firefox"_s,
+                       SearchDocument{{u"Firefox Web Browser"_s}, {u"Web Browser"_s}, {u"Internet;WWW;"_s}, {u"Browse the Web"_s}});
+        m_index.update(u"chromium"_s, SearchDocument{{u"Chromium"_s}, {u"Web Browser"_s}, {}, {}});
+        m_index.update(u"editor"_s,
+                       SearchDocument{{u"文本编辑器"_s, u"Text Editor"_s}, {}, {u"text;notepad;"_s}, {u"Édition de texte"_s}});
+    }
+
+    ApplicationSearchIndex m_index;
+};
+
+TEST_F(TestApplicationSearchIndex, prefixAndRanking)
+{
+    EXPECT_EQ(m_index.search(u"fire"_s, 0), QStringList{u"firefox"_s});
+    // matched by Name is ranked before GenericName
+    EXPECT_EQ(m_index.search(u"brow"_s, 0), (QStringList{u"firefox"_s, u"chromium"_s}));
+    EXPECT_EQ(m_index.search(u"web chrom"_s, 0), QStringList{u"chromium"_s});
+    EXPECT_EQ(m_index.search(u"brow"_s, 1), QStringList{u"firefox"_s});
+    EXPECT_TRUE(m_index.search(u"  "_s, 0).isEmpty());
+}
+
+TEST_F(TestApplicationSearchIndex, normalizationAndFuzzy)
+{
+    EXPECT_EQ(m_index.search(u"EDITION"_s, 0), QStringList{u"editor"_s});
+    EXPECT_EQ(m_index.search(u"编辑"_s, 0), QStringList{u"editor"_s});
+    EXPECT_EQ(m_index.search(u"firefx"_s, 0), QStringList{u"firefox"_s});
+}
+
+TEST_F(TestApplicationSearchIndex, frecency)
+{
+    const auto frecency = [](const QString &appId) -> SearchFrecency {
+        if (appId == u"chromium"_s) {
+            return {100, 1000};
+        }
+        return {};
+    };
+
+    EXPECT_EQ(m_index.search(u"brow"_s, 0, frecency, 1000), (QStringList{u"chromium"_s, u"firefox"_s}));
+}
+
+TEST_F(TestApplicationSearchIndex, incrementalUpdate)
+{
+    m_index.update(u"chromium"_s, SearchDocument{{u"Chrome"_s}, {}, {}, {}});
+    EXPECT_EQ(m_index.search(u"brow"_s, 0), QStringList{u"firefox"_s});
+    EXPECT_EQ(m_index.search(u"chrome"_s, 0), QStringList{u"chromium"_s});
+
+    m_index.remove(u"firefox"_s);
+    EXPECT_TRUE(m_index.search(u"brow"_s, 0).isEmpty());
+    EXPECT_EQ(m_index.size(), 2);
+}
+
+TEST_F(TestApplicationSearchIndex, transliterator)
+{
+    m_index.addTransliterator([](const QString &text) -> QStringList {
+        if (text.contains(u"编辑"_s)) {
+            return {u"bianji"_s};
+        }
+        return {};
+    });
+    m_index.update(u"editor"_s, SearchDocument{{u"文本编辑器"_s}, {}, {}, {}});
+
+    EXPECT_EQ(m_index.search(u"bian"_s, 0), QStringList{u"editor"_s});
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "cgroupsidentifier.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestCGroupsIdentifier, cgroupId)
+{
+    EXPECT_FALSE(CGroupsIdentifier::cgroupIdOf(-1).has_value());
+
+    auto id = CGroupsIdentifier::cgroupIdOf(getpid());
+    if (!id) {
+        GTEST_SKIP_("process isn't in a cgroup v2 hierarchy.");
+    }
+    EXPECT_EQ(CGroupsIdentifier::cgroupIdOf(getpid()), id);
+}
+
+TEST(TestCGroupsIdentifier, unitRemovedDropsCache)
+{
+    CGroupsIdentifier identifier;
+    const auto unit = u"app-DDE-test@3ae4c6cb.service"_s;
+    identifier.m_cache.insert(42, {IdentifyRet{u"test"_s, u"3ae4c6cb"_s, IdentifyConfidence::High}, unit});
+    identifier.m_cache.insert(43, {IdentifyRet{u"test"_s, u"3ae4c6cb"_s, IdentifyConfidence::High}, unit});
+    identifier.m_unitCGroups.insert(unit, {42, 43});
+
+    identifier.unitRemoved(u"app-DDE-other@3ae4c6cb.service"_s);
+    EXPECT_EQ(identifier.m_cache.size(), 2);
+
+    identifier.unitRemoved(unit);
+    EXPECT_TRUE(identifier.m_cache.isEmpty());
+    EXPECT_TRUE(identifier.m_unitCGroups.isEmpty());
+}
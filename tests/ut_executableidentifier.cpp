@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "executableidentifier.h"
+#include "global.h"
+#include <QFileInfo>
+#include <cstring>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestExecutableIdentifier, identifyByExecutable)
+{
+    const auto self = QFileInfo{u"/proc/self/exe"_s}.canonicalFilePath();
+    ASSERT_FALSE(self.isEmpty());
+
+    ApplicationLookupIndex index;
+    ExecutableIdentifier identifier{index};
+    EXPECT_TRUE(identifier.identifyPid(getpid()).ApplicationId.isEmpty());
+
+    index.update(u"self"_s, LookupKeys{{}, {self}, {}});
+    auto ret = identifier.identifyPid(getpid());
+    EXPECT_EQ(ret.ApplicationId, u"self"_s);
+    EXPECT_TRUE(ret.InstanceId.isEmpty());
+    EXPECT_EQ(ret.Confidence, IdentifyConfidence::Medium);
+
+    auto pidfd = pidfd_open(getpid(), 0);
+    ASSERT_TRUE(pidfd > 0) << std::strerror(errno);
+    ret = identifier.Identify(QDBusUnixFileDescriptor{pidfd});
+    ::close(pidfd);
+    EXPECT_EQ(ret.ApplicationId, u"self"_s);
+
+    // an executable shared by several applications is ambiguous
+    index.update(u"another"_s, LookupKeys{{}, {self}, {}});
+    EXPECT_EQ(identifier.identifyPid(getpid()).Confidence, IdentifyConfidence::Low);
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "executableindex.h"
+#include <QFile>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+bool createFile(const QString &path, bool executable)
+{
+    QFile file{path};
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+    file.close();
+
+    auto permissions = QFile::ReadOwner | QFile::WriteOwner;
+    if (executable) {
+        permissions |= QFile::ExeOwner;
+    }
+    return file.setPermissions(permissions);
+}
+}  // namespace
+
+TEST(TestExecutableIndex, find)
+{
+    QTemporaryDir first;
+    QTemporaryDir second;
+    ASSERT_TRUE(first.isValid() && second.isValid());
+    ASSERT_TRUE(createFile(first.filePath(u"shared"_s), true));
+    ASSERT_TRUE(createFile(first.filePath(u"data"_s), false));
+    ASSERT_TRUE(createFile(second.filePath(u"shared"_s), true));
+    ASSERT_TRUE(createFile(second.filePath(u"only-second"_s), true));
+
+    ExecutableIndex index;
+    index.setSearchPaths({first.path(), u"relative/bin"_s, second.path()});
+    EXPECT_EQ(index.searchPaths(), (QStringList{first.path(), second.path()}));
+
+    // the first directory of PATH wins
+    EXPECT_EQ(index.find(u"shared"_s), first.filePath(u"shared"_s));
+    EXPECT_EQ(index.find(u"only-second"_s), second.filePath(u"only-second"_s));
+    EXPECT_TRUE(index.find(u"data"_s).isEmpty());
+    EXPECT_TRUE(index.find(u"missing"_s).isEmpty());
+
+    ASSERT_TRUE(createFile(second.filePath(u"new-program"_s), true));
+    ASSERT_TRUE(QFile::remove(first.filePath(u"shared"_s)));
+    index.onDirectoryChanged(first.path());
+    index.onDirectoryChanged(second.path());
+    index.onDirectoryChanged(second.path());
+    EXPECT_TRUE(index.m_changeTimer.isActive());
+    EXPECT_EQ(index.m_changedDirs.size(), 2);
+    index.applyChanges();
+    EXPECT_FALSE(index.m_changeTimer.isActive());
+    EXPECT_EQ(index.find(u"new-program"_s), second.filePath(u"new-program"_s));
+    EXPECT_EQ(index.find(u"shared"_s), second.filePath(u"shared"_s));
+
+    index.setSearchPaths({second.path()});
+    EXPECT_EQ(index.find(u"shared"_s), second.filePath(u"shared"_s));
+    EXPECT_TRUE(index.m_watcher.directories().contains(second.path()));
+    EXPECT_FALSE(index.m_watcher.directories().contains(first.path()));
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "iconbuffercache.h"
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+struct FakeBuffer
+{
+    explicit FakeBuffer(int &alive)
+        : m_alive(alive)
+    {
+        ++m_alive;
+    }
+    ~FakeBuffer() { --m_alive; }
+    FakeBuffer(const FakeBuffer &) = delete;
+    FakeBuffer &operator=(const FakeBuffer &) = delete;
+
+    const void *buffer() { return this; }
+
+private:
+    int &m_alive;
+};
+}  // namespace
+
+TEST(IconBufferCache, lookupAndEvict)
+{
+    int alive{0};
+    IconBufferCache<FakeBuffer> cache{2};
+    EXPECT_FALSE(cache.lookup(u"a"_s).has_value());
+
+    auto *a = cache.insert(u"a"_s, std::make_unique<FakeBuffer>(alive));
+    cache.insert(u"missing"_s, nullptr);
+    EXPECT_EQ(cache.lookup(u"a"_s), a);
+    EXPECT_EQ(cache.lookup(u"missing"_s), nullptr);
+
+    // "a" is the least recently used one now
+    cache.insert(u"b"_s, std::make_unique<FakeBuffer>(alive));
+    EXPECT_FALSE(cache.lookup(u"a"_s).has_value());
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(alive, 1);
+}
+
+TEST(IconBufferCache, sharedBetweenSplashes)
+{
+    int alive{0};
+    IconBufferCache<FakeBuffer> cache{1};
+    auto *icon = cache.insert(u"icon"_s, std::make_unique<FakeBuffer>(alive));
+    const auto *handle = icon->buffer();
+
+    // two splashes of the same application attach the same buffer
+    cache.attach(handle);
+    cache.attach(handle);
+
+    // an evicted buffer still in use is kept until the compositor releases it, which happens only once
+    cache.insert(u"other"_s, std::make_unique<FakeBuffer>(alive));
+    EXPECT_EQ(cache.evictedSize(), 1);
+    EXPECT_EQ(alive, 2);
+
+    cache.release(handle);
+    EXPECT_EQ(cache.evictedSize(), 0);
+    EXPECT_EQ(alive, 1);
+}
+
+TEST(IconBufferCache, releasedIsIdle)
+{
+    int alive{0};
+    IconBufferCache<FakeBuffer> cache{1};
+    auto *icon = cache.insert(u"icon"_s, std::make_unique<FakeBuffer>(alive));
+    cache.attach(icon->buffer());
+    cache.attach(icon->buffer());
+    cache.release(icon->buffer());
+
+    cache.insert(u"other"_s, std::make_unique<FakeBuffer>(alive));
+    EXPECT_EQ(cache.evictedSize(), 0);
+    EXPECT_EQ(alive, 1);
+}
+
+TEST(IconBufferCache, clearKeepsAttached)
+{
+    int alive{0};
+    IconBufferCache<FakeBuffer> cache{4};
+    auto *idle = cache.insert(u"idle"_s, std::make_unique<FakeBuffer>(alive));
+    auto *attached = cache.insert(u"attached"_s, std::make_unique<FakeBuffer>(alive));
+    static_cast<void>(idle);
+    cache.attach(attached->buffer());
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.evictedSize(), 1);
+    EXPECT_EQ(alive, 1);
+
+    cache.release(attached->buffer());
+    EXPECT_EQ(alive, 0);
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "iconthemeresolver.h"
+#include "utils.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+class TestIconThemeResolver : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        ASSERT_TRUE(writeFile(icons(u"bloom/index.theme"_s),
+                              "[Icon Theme]\nName=Bloom\nInherits=hicolor,base\nDirectories=48x48/apps,scalable/apps\n\n"
+                              "[48x48/apps]\nSize=48\n\n[scalable/apps]\nSize=48\nType=Scalable\n"));
+        ASSERT_TRUE(writeFile(icons(u"base/index.theme"_s),
+                              "[Icon Theme]\nName=Base\nDirectories=32x32/apps,32x32@2/apps\n\n"
+                              "[32x32/apps]\nSize=32\n\n[32x32@2/apps]\nSize=32\nScale=2\n"));
+        ASSERT_TRUE(writeFile(icons(u"hicolor/index.theme"_s),
+                              "[Icon Theme]\nName=Hicolor\nDirectories=48x48/apps\n\n[48x48/apps]\nSize=48\n"));
+
+        ASSERT_TRUE(writeFile(icons(u"bloom/48x48/apps/editor.svg"_s)));
+        ASSERT_TRUE(writeFile(icons(u"bloom/48x48/apps/editor.png"_s)));
+        ASSERT_TRUE(writeFile(icons(u"bloom/scalable/apps/editor.svg"_s)));
+        ASSERT_TRUE(writeFile(icons(u"base/32x32/apps/editor.png"_s)));
+        ASSERT_TRUE(writeFile(icons(u"base/32x32/apps/terminal.png"_s)));
+        ASSERT_TRUE(writeFile(icons(u"base/32x32@2/apps/terminal.png"_s)));
+        ASSERT_TRUE(writeFile(icons(u"hicolor/48x48/apps/terminal.png"_s)));
+        ASSERT_TRUE(writeFile(m_dir.filePath(u"pixmaps/legacy.xpm"_s)));
+
+        m_resolver = std::make_unique<IconThemeResolver>(
+            u"bloom"_s, QStringList{m_dir.filePath(u"icons"_s)}, QStringList{m_dir.filePath(u"pixmaps"_s)});
+    }
+
+    [[nodiscard]] QString icons(const QString &path) const { return m_dir.filePath(u"icons/"_s + path); }
+
+    QTemporaryDir m_dir;
+    std::unique_ptr<IconThemeResolver> m_resolver;
+};
+
+TEST_F(TestIconThemeResolver, resolve)
+{
+    auto editor = m_resolver->resolve(u"editor"_s);
+    EXPECT_EQ(editor.size(), 2);
+    EXPECT_EQ(editor.value(u"48"_s), icons(u"bloom/48x48/apps/editor.png"_s));
+    EXPECT_EQ(editor.value(u"scalable"_s), icons(u"bloom/scalable/apps/editor.svg"_s));
+
+    // hicolor is looked up after every other parent
+    auto terminal = m_resolver->resolve(u"terminal"_s);
+    EXPECT_EQ(terminal.size(), 2);
+    EXPECT_EQ(terminal.value(u"32"_s), icons(u"base/32x32/apps/terminal.png"_s));
+    EXPECT_EQ(terminal.value(u"32@2"_s), icons(u"base/32x32@2/apps/terminal.png"_s));
+
+    EXPECT_EQ(m_resolver->resolve(u"legacy"_s).value(u"0"_s), m_dir.filePath(u"pixmaps/legacy.xpm"_s));
+    EXPECT_TRUE(m_resolver->resolve(u"missing"_s).isEmpty());
+    EXPECT_TRUE(m_resolver->resolve(QString{}).isEmpty());
+}
+
+TEST_F(TestIconThemeResolver, directoryChanged)
+{
+    EXPECT_TRUE(m_resolver->resolve(u"viewer"_s).isEmpty());
+
+    const auto dir = icons(u"bloom/48x48/apps"_s);
+    ASSERT_TRUE(writeFile(dir + u"/viewer.png"_s));
+    ASSERT_TRUE(QFile::remove(dir + u"/editor.png"_s));
+    m_resolver->onDirectoryChanged(dir);
+
+    EXPECT_EQ(m_resolver->resolve(u"viewer"_s).value(u"48"_s), dir + u"/viewer.png"_s);
+    EXPECT_EQ(m_resolver->resolve(u"editor"_s).value(u"48"_s), dir + u"/editor.svg"_s);
+}
+
+TEST_F(TestIconThemeResolver, watchedBeforeResolve)
+{
+    // nothing has been resolved yet, changes must still be noticed
+    const auto dir = icons(u"bloom/48x48/apps"_s);
+    EXPECT_TRUE(m_resolver->m_watcher.directories().contains(dir));
+
+    m_resolver->invalidate();
+    EXPECT_TRUE(m_resolver->m_watcher.directories().contains(dir));
+    EXPECT_TRUE(m_resolver->m_watcher.files().contains(icons(u"bloom/index.theme"_s)));
+}
+
+TEST_F(TestIconThemeResolver, ignoreCacheChurn)
+{
+    // a rewritten icon-theme.cache changes nothing of the theme chain
+    const auto theme = icons(u"bloom"_s);
+    ASSERT_TRUE(writeFile(theme + u"/icon-theme.cache"_s, "cache"));
+    m_resolver->onDirectoryChanged(theme);
+    EXPECT_FALSE(m_resolver->m_invalidateTimer.isActive());
+
+    // a new directory may belong to the theme, invalidation is debounced
+    ASSERT_TRUE(QDir{theme}.mkpath(u"64x64/apps"_s));
+    m_resolver->onDirectoryChanged(theme);
+    EXPECT_TRUE(m_resolver->m_invalidateTimer.isActive());
+    EXPECT_EQ(m_resolver->resolve(u"editor"_s).size(), 2);
+}
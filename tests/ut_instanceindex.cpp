@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbus/instanceservice.h"
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestInstanceIndex, lookupAndOrphan)
+{
+    auto &index = InstanceIndex::instance();
+    const auto application = u"/org/desktopspec/ApplicationManager1/index_2dtest"_s;
+    const auto unitPath = u"/org/freedesktop/systemd1/unit/app_2dDDE_2dindex_2dtest_40abcd_2eservice"_s;
+    const QDBusObjectPath objectPath{application + u"/abcd"_s};
+    auto instance = QSharedPointer<InstanceService>::create(u"abcd"_s, application, unitPath, u"DDE"_s);
+
+    index.insert(u"index-test"_s, objectPath, instance);
+    const auto *entry = index.findByUnitPath(unitPath);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->appId, u"index-test"_s);
+    EXPECT_EQ(entry->objectPath, objectPath);
+    EXPECT_EQ(index.findByInstanceId(u"abcd"_s), entry);
+    EXPECT_EQ(index.findByInstanceId(u"dcba"_s), nullptr);
+
+    index.setUnitResult(unitPath, u"exit-code"_s);
+    index.setUnitResult(u"/org/freedesktop/systemd1/unit/other_2eservice"_s, u"timeout"_s);
+    EXPECT_EQ(index.findByUnitPath(unitPath)->unitResult, u"exit-code"_s);
+    EXPECT_EQ(index.findByUnitPath(u"/org/freedesktop/systemd1/unit/other_2eservice"_s), nullptr);
+
+    index.orphan(unitPath);
+    entry = index.findByUnitPath(unitPath);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_TRUE(entry->orphaned);
+
+    index.remove(unitPath);
+    EXPECT_EQ(index.findByUnitPath(unitPath), nullptr);
+    EXPECT_EQ(index.findByInstanceId(u"abcd"_s), nullptr);
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationmimeinfo.h"
+#include "utils.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestMimeCache, reverseIndex)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = dir.filePath(u"mimeinfo.cache"_s);
+    ASSERT_TRUE(writeFile(path,
+                          "[MIME Cache]\n"
+                          "text/plain=editor.desktop;viewer.desktop;\n"
+                          "text/html=browser.desktop;editor.desktop;editor.desktop;\n"
+                          "image/png=viewer.desktop;broken;\n"));
+
+    auto cache = MimeCache::createMimeCache(path);
+    ASSERT_TRUE(cache.has_value());
+    EXPECT_TRUE(MimeCacheIndex::sidecarPathOf(path).startsWith(qEnvironmentVariable("XDG_CACHE_HOME") + u'/'));
+    EXPECT_TRUE(QFile::exists(MimeCacheIndex::sidecarPathOf(path)));
+
+    auto editor = cache->queryTypes(u"editor"_s);
+    std::sort(editor.begin(), editor.end());
+    EXPECT_EQ(editor, (QStringList{u"text/html"_s, u"text/plain"_s}));
+
+    auto viewer = cache->queryTypes(u"viewer"_s);
+    std::sort(viewer.begin(), viewer.end());
+    EXPECT_EQ(viewer, (QStringList{u"image/png"_s, u"text/plain"_s}));
+
+    EXPECT_TRUE(cache->queryTypes(u"broken"_s).isEmpty());
+    EXPECT_TRUE(cache->queryTypes(u"missing"_s).isEmpty());
+    EXPECT_EQ(cache->queryApps(u"text/html"_s), (QStringList{u"browser"_s, u"editor"_s, u"editor"_s}));
+
+    ASSERT_TRUE(writeFile(path, "[MIME Cache]\ntext/plain=viewer.desktop;\n"));
+    cache->reload();
+    EXPECT_TRUE(cache->queryTypes(u"editor"_s).isEmpty());
+    EXPECT_EQ(cache->queryTypes(u"viewer"_s), QStringList{u"text/plain"_s});
+}
+
+TEST(TestMimeCache, sidecar)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto source = dir.filePath(u"mimeinfo.cache"_s);
+    const auto sidecar = dir.filePath(u"index/mimeinfo.idx"_s);
+    ASSERT_TRUE(writeFile(source, "[MIME Cache]\ntext/plain=editor.desktop;viewer.desktop;\nimage/png=viewer.desktop;\n"));
+
+    auto index = MimeCacheIndex::load(source, sidecar);
+    ASSERT_NE(index, nullptr);
+    ASSERT_TRUE(QFile::exists(sidecar));
+    EXPECT_EQ(index->types(), (QStringList{u"image/png"_s, u"text/plain"_s}));
+    EXPECT_EQ(index->appsOf(u"text/plain"_s), (QStringList{u"editor"_s, u"viewer"_s}));
+    EXPECT_EQ(index->typesOf(u"viewer"_s), (QStringList{u"image/png"_s, u"text/plain"_s}));
+    EXPECT_TRUE(index->appsOf(u"text/html"_s).isEmpty());
+
+    // an up to date sidecar is mapped without touching the source
+    const auto modified = QFileInfo{sidecar}.lastModified();
+    auto mapped = MimeCacheIndex::load(source, sidecar);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(QFileInfo{sidecar}.lastModified(), modified);
+    EXPECT_EQ(mapped->appsOf(u"image/png"_s), QStringList{u"viewer"_s});
+
+    // a broken sidecar is compiled again, even if its header still matches the source
+    QFile file{sidecar};
+    ASSERT_TRUE(file.open(QFile::ReadOnly));
+    const auto content = file.readAll();
+    file.close();
+    ASSERT_GE(content.size(), static_cast<qsizetype>(sizeof(MimeCacheIndexHeader) + sizeof(MimeCacheIndexRecord)));
+
+    auto brokenHeader = content;
+    reinterpret_cast<MimeCacheIndexHeader *>(brokenHeader.data())->stringsOffset = static_cast<quint32>(content.size());
+    ASSERT_TRUE(writeFile(sidecar, brokenHeader));
+    auto recompiled = MimeCacheIndex::load(source, sidecar);
+    ASSERT_NE(recompiled, nullptr);
+    EXPECT_EQ(recompiled->appsOf(u"text/plain"_s), (QStringList{u"editor"_s, u"viewer"_s}));
+
+    auto brokenRecord = content;
+    const auto *head = reinterpret_cast<const MimeCacheIndexHeader *>(brokenRecord.data());
+    reinterpret_cast<MimeCacheIndexRecord *>(brokenRecord.data() + head->typesOffset)->first = head->refCount;
+    ASSERT_TRUE(writeFile(sidecar, brokenRecord));
+    recompiled = MimeCacheIndex::load(source, sidecar);
+    ASSERT_NE(recompiled, nullptr);
+    EXPECT_EQ(recompiled->appsOf(u"image/png"_s), QStringList{u"viewer"_s});
+
+    // so is a stale one
+    ASSERT_TRUE(writeFile(source, "[MIME Cache]\ntext/html=browser.desktop;\n"));
+    auto updated = MimeCacheIndex::load(source, sidecar);
+    ASSERT_NE(updated, nullptr);
+    EXPECT_EQ(updated->types(), QStringList{u"text/html"_s});
+    // the old mapping stays valid for its holders
+    EXPECT_EQ(index->appsOf(u"text/plain"_s), (QStringList{u"editor"_s, u"viewer"_s}));
+}
+
+TEST(TestMimeCache, pruneSidecars)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto kept = dir.filePath(u"kept.cache"_s);
+    const auto removed = dir.filePath(u"removed.cache"_s);
+    ASSERT_TRUE(writeFile(kept, "[MIME Cache]\ntext/plain=editor.desktop;\n"));
+    ASSERT_TRUE(writeFile(removed, "[MIME Cache]\ntext/html=browser.desktop;\n"));
+    ASSERT_NE(MimeCacheIndex::load(kept), nullptr);
+    ASSERT_NE(MimeCacheIndex::load(removed), nullptr);
+    ASSERT_TRUE(QFile::exists(MimeCacheIndex::sidecarPathOf(removed)));
+
+    MimeCacheIndex::prune({kept});
+    EXPECT_TRUE(QFile::exists(MimeCacheIndex::sidecarPathOf(kept)));
+    EXPECT_FALSE(QFile::exists(MimeCacheIndex::sidecarPathOf(removed)));
+}
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "applicationmimeinfo.h"
+#include "utils.h"
+#include <QDir>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(TestMimeInfo, detectChanges)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDir root{dir.path()};
+    const auto list = root.filePath(u"mimeapps.list"_s);
+    ASSERT_TRUE(writeFile(list, "[Default Applications]\ntext/plain=editor.desktop;\n"));
+
+    auto info = MimeInfo::createMimeInfo(dir.path());
+    ASSERT_TRUE(info.has_value());
+    ASSERT_EQ(info->appsList().size(), 1);
+    auto &apps = info->appsList().front();
+    EXPECT_FALSE(apps.isModified());
+    EXPECT_FALSE(info->isLayoutChanged());
+
+    ASSERT_TRUE(writeFile(list, "[Default Applications]\ntext/plain=other-editor.desktop;\n"));
+    EXPECT_TRUE(apps.isModified());
+    apps.reload();
+    EXPECT_FALSE(apps.isModified());
+    EXPECT_EQ(apps.queryDefaultApp(u"text/plain"_s), u"other-editor"_s);
+
+    // what we wrote ourselves needn't be parsed again
+    ASSERT_TRUE(writeFile(list, "[Default Applications]\ntext/plain=other-editor.desktop;\ntext/html=browser.desktop;\n"));
+    EXPECT_TRUE(apps.isModified());
+    apps.updateStamp();
+    EXPECT_FALSE(apps.isModified());
+
+    // a new file in the directory requires loading it again
+    ASSERT_TRUE(writeFile(root.filePath(u"mimeinfo.cache"_s), "[MIME Cache]\ntext/plain=editor.desktop;\n"));
+    EXPECT_TRUE(info->isLayoutChanged());
+}
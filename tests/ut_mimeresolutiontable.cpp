@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "global.h"
+#include "mimeresolutiontable.h"
+#include "utils.h"
+#include <QDir>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+class TestMimeResolutionTable : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_user.isValid() && m_system.isValid());
+        ASSERT_FALSE(getCurrentDesktops().isEmpty());
+
+        // user directory: desktop specific list has higher precedence than mimeapps.list
+        ASSERT_TRUE(writeFile(QDir{m_user.path()}.filePath(getCurrentDesktops().constFirst() + u"-mimeapps.list"_s),
+                              "[Default Applications]\ntext/plain=desktop-editor.desktop;\n"));
+        ASSERT_TRUE(writeFile(userList(),
+                              "[Default Applications]\ntext/plain=user-editor.desktop;\nimage/png=viewer.desktop;\n\n"
+                              "[Added Associations]\ntext/plain=user-editor.desktop;viewer.desktop;\n\n"
+                              "[Removed Associations]\ntext/plain=system-editor.desktop;\n"));
+        ASSERT_TRUE(writeFile(QDir{m_system.path()}.filePath(u"mimeapps.list"_s),
+                              "[Default Applications]\ntext/plain=system-editor.desktop;\ntext/html=browser.desktop;\n\n"
+                              "[Added Associations]\ntext/plain=system-editor.desktop;other.desktop;\n"));
+        ASSERT_TRUE(writeFile(QDir{m_system.path()}.filePath(u"mimeinfo.cache"_s),
+                              "[MIME Cache]\ntext/plain=system-editor.desktop;viewer.desktop;\ntext/html=browser.desktop;\n"));
+
+        for (const auto &dir : {m_user.path(), m_system.path()}) {
+            auto info = MimeInfo::createMimeInfo(dir);
+            ASSERT_TRUE(info.has_value());
+            m_infos.emplace_back(std::move(info).value());
+        }
+        m_table.rebuild(m_infos);
+    }
+
+    [[nodiscard]] QString userList() const { return QDir{m_user.path()}.filePath(u"mimeapps.list"_s); }
+
+    QTemporaryDir m_user;
+    QTemporaryDir m_system;
+    std::vector<MimeInfo> m_infos;
+    MimeResolutionTable m_table;
+};
+
+TEST_F(TestMimeResolutionTable, precedence)
+{
+    const auto *plain = m_table.find(u"text/plain"_s);
+    ASSERT_NE(plain, nullptr);
+    EXPECT_EQ(plain->defaults, (QStringList{u"desktop-editor"_s, u"user-editor"_s, u"system-editor"_s}));
+    EXPECT_EQ(m_table.defaultApplication(u"text/plain"_s), u"desktop-editor"_s);
+
+    // removals of a higher precedence file hide associations added by lower ones
+    EXPECT_EQ(plain->added, (QStringList{u"user-editor"_s, u"viewer"_s, u"other"_s}));
+    EXPECT_EQ(plain->removed, QStringList{u"system-editor"_s});
+    EXPECT_EQ(m_table.cachedApplications(u"text/plain"_s), (QStringList{u"system-editor"_s, u"viewer"_s}));
+
+    EXPECT_EQ(m_table.defaultApplication(u"text/html"_s), u"browser"_s);
+    EXPECT_EQ(m_table.defaultApplication(u"image/png"_s), u"viewer"_s);
+    EXPECT_EQ(m_table.find(u"application/x-unknown"_s), nullptr);
+}
+
+TEST_F(TestMimeResolutionTable, updateFile)
+{
+    auto &userApps = m_infos.front().appsList().back();
+    ASSERT_EQ(userApps.fileInfo().absoluteFilePath(), QFileInfo{userList()}.absoluteFilePath());
+
+    ASSERT_TRUE(writeFile(userList(), "[Default Applications]\ntext/html=user-browser.desktop;\n"));
+    userApps.reload();
+    ASSERT_TRUE(m_table.updateFile(userApps));
+
+    EXPECT_EQ(m_table.defaultApplication(u"text/html"_s), u"user-browser"_s);
+    EXPECT_EQ(m_table.defaultApplication(u"text/plain"_s), u"desktop-editor"_s);
+    EXPECT_EQ(m_table.defaultApplication(u"image/png"_s), QString{});
+    EXPECT_EQ(m_table.find(u"text/plain"_s)->added, (QStringList{u"system-editor"_s, u"other"_s}));
+
+    QTemporaryDir other;
+    ASSERT_TRUE(other.isValid());
+    const auto otherCache = QDir{other.path()}.filePath(u"mimeinfo.cache"_s);
+    ASSERT_TRUE(writeFile(otherCache, "[MIME Cache]\ntext/plain=viewer.desktop;\n"));
+    auto cache = MimeCache::createMimeCache(otherCache);
+    ASSERT_TRUE(cache.has_value());
+    EXPECT_FALSE(m_table.updateFile(*cache));
+}
+
+TEST_F(TestMimeResolutionTable, resolveDefault)
+{
+    // text/x-c++src inherits text/x-csrc which inherits text/plain
+    auto resolved = m_table.resolveDefault(u"text/x-c++src"_s);
+    EXPECT_EQ(resolved.appId, u"desktop-editor"_s);
+    EXPECT_EQ(resolved.matchedType, u"text/plain"_s);
+
+    resolved = m_table.resolveDefault(u"text/html"_s);
+    EXPECT_EQ(resolved.appId, u"browser"_s);
+    EXPECT_EQ(resolved.matchedType, u"text/html"_s);
+
+    resolved = m_table.resolveDefault(u"x-unknown/x-unknown"_s);
+    EXPECT_TRUE(resolved.appId.isEmpty());
+    EXPECT_TRUE(resolved.matchedType.isEmpty());
+    // types unknown to shared-mime-info come from clients and aren't memoized
+    EXPECT_FALSE(m_table.m_defaultMemo.contains(u"x-unknown/x-unknown"_s));
+    EXPECT_TRUE(m_table.m_defaultMemo.contains(u"text/html"_s));
+
+    // the memo must not survive a change of the table
+    auto &userApps = m_infos.front().appsList().back();
+    userApps.setDefaultApplication(u"text/x-c++src"_s, u"ide"_s);
+    ASSERT_TRUE(m_table.updateFile(userApps));
+
+    resolved = m_table.resolveDefault(u"text/x-c++src"_s);
+    EXPECT_EQ(resolved.appId, u"ide"_s);
+    EXPECT_EQ(resolved.matchedType, u"text/x-c++src"_s);
+}
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "mimetypesniffer.h"
+#include "utils.h"
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Qt::StringLiterals;
+
+TEST(MimeTypeSniffer, sniffAndCache)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDir root{dir.path()};
+
+    const auto text = root.filePath(u"note.txt"_s);
+    // content wins over the misleading extension
+    const auto png = root.filePath(u"image.dat"_s);
+    ASSERT_TRUE(writeFile(text, "hello world\n"));
+    ASSERT_TRUE(writeFile(png, QByteArray::fromHex("89504e470d0a1a0a0000000d49484452")));
+
+    MimeTypeSniffer sniffer;
+    const QStringList paths{text, png, dir.path(), text, root.filePath(u"missing"_s), u"text/plain"_s};
+    const auto types = sniffer.mimeTypesForFiles(paths);
+    ASSERT_EQ(types.size(), paths.size());
+    EXPECT_EQ(types.at(0), u"text/plain"_s);
+    EXPECT_EQ(types.at(1), u"image/png"_s);
+    EXPECT_EQ(types.at(2), u"inode/directory"_s);
+    EXPECT_EQ(types.at(3), u"text/plain"_s);
+    EXPECT_TRUE(types.at(4).isEmpty());
+    EXPECT_TRUE(types.at(5).isEmpty());
+    EXPECT_EQ(sniffer.cacheSize(), 3);
+
+    EXPECT_EQ(sniffer.mimeTypesForFiles({png}), QStringList{u"image/png"_s});
+    EXPECT_EQ(sniffer.cacheSize(), 3);
+
+    // a modified file gets a new key
+    ASSERT_TRUE(writeFile(png, "#!/bin/sh\necho hello\n"));
+    EXPECT_EQ(sniffer.mimeTypesForFiles({png}), QStringList{u"application/x-shellscript"_s});
+    EXPECT_EQ(sniffer.cacheSize(), 4);
+}
+
+TEST(MimeTypeSniffer, renamedFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDir root{dir.path()};
+    const auto text = root.filePath(u"a.txt"_s);
+    const auto source = root.filePath(u"a.c"_s);
+    const auto linked = root.filePath(u"b.c"_s);
+    ASSERT_TRUE(writeFile(text, "hello world\n"));
+
+    MimeTypeSniffer sniffer;
+    EXPECT_EQ(sniffer.mimeTypesForFiles({text}), QStringList{u"text/plain"_s});
+
+    // renaming and hard linking keep inode, mtime and size, but the name changes the type
+    ASSERT_EQ(::link(QFile::encodeName(text).constData(), QFile::encodeName(linked).constData()), 0);
+    ASSERT_TRUE(QFile::rename(text, source));
+    EXPECT_EQ(sniffer.mimeTypesForFiles({source, linked}), (QStringList{u"text/x-csrc"_s, u"text/x-csrc"_s}));
+}
+
+TEST(MimeTypeSniffer, capacity)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    QStringList paths;
+    for (int i = 0; i < 5; ++i) {
+        paths.append(QDir{dir.path()}.filePath(QString::number(i) + u".txt"_s));
+        ASSERT_TRUE(writeFile(paths.constLast(), QByteArray::number(i)));
+    }
+
+    MimeTypeSniffer sniffer{3};
+    const auto types = sniffer.mimeTypesForFiles(paths);
+    EXPECT_EQ(types, QStringList(5, u"text/plain"_s));
+    EXPECT_LE(sniffer.cacheSize(), 3);
+}
+
+TEST(MimeTypeSniffer, fifoIsNotOpened)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QDir root{dir.path()};
+
+    const auto fifo = root.filePath(u"pipe"_s);
+    ASSERT_EQ(::mkfifo(QFile::encodeName(fifo).constData(), 0600), 0);
+    const auto text = root.filePath(u"note.txt"_s);
+    ASSERT_TRUE(writeFile(text, "hello world\n"));
+
+    // opening a FIFO without a writer would block forever, both on the calling thread and on the pool
+    MimeTypeSniffer single;
+    EXPECT_EQ(single.mimeTypesForFiles({fifo}), QStringList{u"inode/fifo"_s});
+    MimeTypeSniffer batch;
+    EXPECT_EQ(batch.mimeTypesForFiles({fifo, text}), (QStringList{u"inode/fifo"_s, u"text/plain"_s}));
+}
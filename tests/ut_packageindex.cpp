@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "packageindex.h"
+#include "utils.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <gtest/gtest.h>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr auto Status = "Package: firefox\n"
+                        "Status: install ok installed\n"
+                        "Architecture: amd64\n"
+                        "Version: 1.0-1\n"
+                        "\n"
+                        "Package: removed\n"
+                        "Status: deinstall ok config-files\n"
+                        "Version: 2.0\n"
+                        "\n"
+                        "Package: editor\n"
+                        "Status: install ok installed\n"
+                        "Version: 3.1\n";
+}  // namespace
+
+class TestPackageIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        ASSERT_TRUE(QDir{m_dir.path()}.mkpath(u"info"_s));
+        ASSERT_TRUE(writeFile(m_dir.filePath(u"status"_s), Status));
+        ASSERT_TRUE(writeFile(m_dir.filePath(u"info/firefox:amd64.list"_s),
+                              "/usr/bin/firefox\n/usr/share/applications/firefox.desktop\n"));
+        ASSERT_TRUE(writeFile(m_dir.filePath(u"info/editor.list"_s),
+                              "/usr/share/applications/org/editor.desktop\n/usr/share/doc/editor.desktop\n"));
+        ASSERT_TRUE(writeFile(m_dir.filePath(u"info/removed.list"_s), "/usr/share/applications/removed.desktop\n"));
+    }
+
+    QTemporaryDir m_dir;
+};
+
+TEST_F(TestPackageIndex, parseStatus)
+{
+    auto versions = PackageIndex::parseStatus(QByteArrayView{Status});
+    EXPECT_EQ(versions.size(), 2);
+    EXPECT_EQ(versions.value(u"firefox"_s), u"1.0-1"_s);
+    EXPECT_EQ(versions.value(u"editor"_s), u"3.1"_s);
+    EXPECT_FALSE(versions.contains(u"removed"_s));
+}
+
+TEST_F(TestPackageIndex, build)
+{
+    auto snapshot = PackageIndex::build(nullptr, m_dir.path());
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(snapshot->lists.size(), 3);
+    EXPECT_EQ(snapshot->desktopIds.value(u"firefox"_s), u"firefox"_s);
+    EXPECT_EQ(snapshot->desktopIds.value(u"org-editor"_s), u"editor"_s);
+    EXPECT_EQ(snapshot->desktopFiles.value(u"/usr/share/applications/org/editor.desktop"_s), u"editor"_s);
+    EXPECT_FALSE(snapshot->desktopFiles.contains(u"/usr/share/doc/editor.desktop"_s));
+    EXPECT_FALSE(snapshot->desktopIds.contains(u"removed"_s));
+}
+
+TEST_F(TestPackageIndex, incrementalBuild)
+{
+    auto first = PackageIndex::build(nullptr, m_dir.path());
+    ASSERT_TRUE(writeFile(m_dir.filePath(u"info/editor.list"_s),
+                          "/usr/share/applications/org/editor.desktop\n/usr/share/applications/editor-extra.desktop\n"));
+
+    auto second = PackageIndex::build(first, m_dir.path());
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->lists.value(u"editor.list"_s).desktopFiles.size(), 2);
+    EXPECT_EQ(second->desktopIds.value(u"editor-extra"_s), u"editor"_s);
+    EXPECT_EQ(second->lists.value(u"firefox:amd64.list"_s).desktopFiles,
+              first->lists.value(u"firefox:amd64.list"_s).desktopFiles);
+}
+
+TEST_F(TestPackageIndex, reuseStatus)
+{
+    const auto path = m_dir.filePath(u"status"_s);
+    auto first = PackageIndex::build(nullptr, m_dir.path());
+    ASSERT_TRUE(first);
+    const auto mtime = QFileInfo{path}.lastModified();
+
+    // same size and mtime, the status isn't parsed again
+    ASSERT_TRUE(writeFile(path, QByteArray{Status}.replace("3.1", "3.2")));
+    QFile status{path};
+    ASSERT_TRUE(status.open(QFile::ReadWrite));
+    ASSERT_TRUE(status.setFileTime(mtime, QFileDevice::FileModificationTime));
+    status.close();
+    auto second = PackageIndex::build(first, m_dir.path());
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->versions.value(u"editor"_s), u"3.1"_s);
+
+    ASSERT_TRUE(writeFile(path, QByteArray{Status}.replace("3.1", "3.10")));
+    auto third = PackageIndex::build(second, m_dir.path());
+    ASSERT_TRUE(third);
+    EXPECT_EQ(third->versions.value(u"editor"_s), u"3.10"_s);
+}
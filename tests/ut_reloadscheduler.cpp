@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "reloadscheduler.h"
+#include <gtest/gtest.h>
+
+namespace {
+constexpr ReloadScheduler::Policy TestPolicy{100, 800, 1000, 3000, 10000};
+}  // namespace
+
+TEST(ReloadSchedulerTest, isolatedChange)
+{
+    ReloadScheduler scheduler{TestPolicy};
+    EXPECT_FALSE(scheduler.hasPending());
+    EXPECT_EQ(scheduler.addChange(0, false), 100);
+    EXPECT_TRUE(scheduler.hasPending());
+    EXPECT_EQ(scheduler.remaining(60, false), 40);
+    EXPECT_EQ(scheduler.remaining(100, false), 0);
+
+    scheduler.reloaded();
+    EXPECT_FALSE(scheduler.hasPending());
+
+    // a change after a quiet period starts over with the short delay
+    EXPECT_EQ(scheduler.addChange(5000, false), 100);
+    scheduler.reloaded();
+    EXPECT_EQ(scheduler.reloads(), 2U);
+    EXPECT_EQ(scheduler.savedReloads(), 0U);
+}
+
+TEST(ReloadSchedulerTest, burstGrowsWindow)
+{
+    ReloadScheduler scheduler{TestPolicy};
+    EXPECT_EQ(scheduler.addChange(0, false), 100);
+    EXPECT_EQ(scheduler.addChange(50, false), 200);
+    EXPECT_EQ(scheduler.addChange(100, false), 400);
+    EXPECT_EQ(scheduler.addChange(150, false), 800);
+    EXPECT_EQ(scheduler.addChange(200, false), 800);
+
+    scheduler.reloaded();
+    EXPECT_EQ(scheduler.changes(), 5U);
+    EXPECT_EQ(scheduler.reloads(), 1U);
+    EXPECT_EQ(scheduler.savedReloads(), 4U);
+}
+
+TEST(ReloadSchedulerTest, maxStaleness)
+{
+    ReloadScheduler scheduler{TestPolicy};
+    qint64 now{0};
+    qint64 delay{0};
+    while (now < 2900) {
+        delay = scheduler.addChange(now, false);
+        now += 200;
+    }
+
+    // changes keep coming, but the first one mustn't wait longer than maxStaleness
+    EXPECT_EQ(delay, 3000 - 2800);
+    EXPECT_EQ(scheduler.remaining(3000, false), 0);
+}
+
+TEST(ReloadSchedulerTest, holdDuringTransaction)
+{
+    ReloadScheduler scheduler{TestPolicy};
+    EXPECT_EQ(scheduler.addChange(0, true), 800);
+    EXPECT_EQ(scheduler.remaining(800, true), 800);
+    EXPECT_EQ(scheduler.remaining(9500, true), 500);
+    EXPECT_EQ(scheduler.remaining(10000, true), 0);
+
+    // the transaction ended, changes held so far are overdue
+    EXPECT_EQ(scheduler.addChange(5000, false), 0);
+}
+
+TEST(ReloadSchedulerTest, coverTransaction)
+{
+    ReloadScheduler scheduler{TestPolicy};
+    EXPECT_FALSE(scheduler.coverTransaction());
+
+    (void)scheduler.addChange(0, true);
+    (void)scheduler.addChange(10, true);
+    EXPECT_TRUE(scheduler.coverTransaction());
+    EXPECT_FALSE(scheduler.hasPending());
+    EXPECT_EQ(scheduler.reloads(), 0U);
+    EXPECT_EQ(scheduler.savedReloads(), 2U);
+
+    // a change outside of the transaction isn't known to the package manager
+    (void)scheduler.addChange(5000, false);
+    (void)scheduler.addChange(5010, true);
+    EXPECT_FALSE(scheduler.coverTransaction());
+    EXPECT_TRUE(scheduler.hasPending());
+}
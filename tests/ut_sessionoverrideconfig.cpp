@@ -9,6 +9,9 @@
 #include "sessionoverrideconfig.h"
 #include "sessiontype.h"
 #include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 #include <QTextStream>
 #include <QTemporaryFile>
 
@@ -102,6 +105,74 @@ TEST(SessionOverrideConfigTest, HasOverrideDetectsPresence)
     EXPECT_FALSE(config.hasOverride(u"org.example.missing"_s));
 }
 
+TEST(SessionOverrideConfigTest, DiscoverOverridesListsOnlyOverriddenApps)
+{
+    QTemporaryDir root;
+    ASSERT_TRUE(root.isValid());
+    const QDir configDir{root.filePath(fromStaticRaw(ApplicationServiceID) + u"/org.deepin.dde.am.appoverride"_s)};
+    auto touch = [&configDir](const QString &relative) {
+        const auto path = configDir.filePath(relative);
+        QDir{}.mkpath(QFileInfo{path}.path());
+        QFile file{path};
+        return file.open(QFile::WriteOnly);
+    };
+
+    ASSERT_TRUE(touch(u"org.example.wayland/wayland/override.json"_s));
+    ASSERT_TRUE(touch(u"org.example.x11/x11/override.json"_s));
+    ASSERT_TRUE(touch(u"org.example.both/override.json"_s));
+    ASSERT_TRUE(QDir{}.mkpath(configDir.filePath(u"org.example.empty/wayland"_s)));
+
+    auto discovered = SessionOverrideConfig::discoverOverrides({root.path(), root.filePath(u"missing"_s)}, u"wayland");
+    ASSERT_TRUE(discovered.has_value());
+    EXPECT_EQ(*discovered, (QSet<QString>{u"org.example.wayland"_s, u"org.example.both"_s}));
+
+    // an override for the whole config applies to every application
+    ASSERT_TRUE(touch(u"global.json"_s));
+    EXPECT_FALSE(SessionOverrideConfig::discoverOverrides({root.path()}, u"wayland").has_value());
+}
+
+TEST(SessionOverrideConfigTest, WatchesExistingApplicationDirectories)
+{
+    QTemporaryDir root;
+    ASSERT_TRUE(root.isValid());
+    const QDir configDir{root.filePath(fromStaticRaw(ApplicationServiceID) + u"/org.deepin.dde.am.appoverride"_s)};
+    ASSERT_TRUE(QDir{}.mkpath(configDir.filePath(u"org.example.app/wayland"_s)));
+    ASSERT_TRUE(QDir{}.mkpath(configDir.filePath(u"org.example.other/x11"_s)));
+
+    // nothing is overridden yet, a file added later into these directories must be noticed
+    const auto discovered = SessionOverrideConfig::discoverOverrides({root.path()}, u"wayland");
+    ASSERT_TRUE(discovered.has_value());
+    EXPECT_TRUE(discovered->isEmpty());
+
+    // <root>/org.deepin.dde.am.appoverride and the missing root show up in the root directory
+    const auto dirs = SessionOverrideConfig::overrideWatchDirs({root.path(), root.filePath(u"missing"_s)}, u"wayland");
+    EXPECT_EQ(QSet<QString>(dirs.cbegin(), dirs.cend()),
+              (QSet<QString>{root.path(),
+                             configDir.path(),
+                             configDir.filePath(u"org.example.app"_s),
+                             configDir.filePath(u"org.example.app/wayland"_s),
+                             configDir.filePath(u"org.example.other"_s)}));
+
+    QFile file{configDir.filePath(u"org.example.app/wayland/override.json"_s)};
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.close();
+    EXPECT_EQ(SessionOverrideConfig::discoverOverrides({root.path()}, u"wayland"), QSet<QString>{u"org.example.app"_s});
+}
+
+TEST(SessionOverrideConfigTest, WatchesAncestorsOfMissingDirectories)
+{
+    QTemporaryDir root;
+    ASSERT_TRUE(root.isValid());
+    const auto overrides = root.filePath(u"overrides"_s);
+    EXPECT_EQ(SessionOverrideConfig::overrideWatchDirs({overrides}, u"wayland"), QStringList{root.path()});
+
+    // the watch moves down as the directories of an override get installed
+    const auto appRoot = overrides + u'/' + fromStaticRaw(ApplicationServiceID);
+    ASSERT_TRUE(QDir{}.mkpath(appRoot));
+    const auto dirs = SessionOverrideConfig::overrideWatchDirs({overrides}, u"wayland");
+    EXPECT_EQ(QSet<QString>(dirs.cbegin(), dirs.cend()), (QSet<QString>{appRoot, overrides}));
+}
+
 TEST(SessionOverrideConfigTest, ResolveExecValueSubstitutesFullPlaceholder)
 {
     EXPECT_EQ(SessionOverrideConfig::resolveExecValue(u"!AM_FULL! --flag"_s, u"/usr/bin/prog %U"_s),
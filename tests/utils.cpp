@@ -2,13 +2,29 @@
 //
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
+#include "utils.h"
 #include "global.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 
 bool registerObjectToDBus(QObject *, const QString &, const QString &) noexcept
 {
     return true;
 }
 
+bool registerVirtualObjectToDBus(QDBusVirtualObject *, const QString &) noexcept
+{
+    return true;
+}
+
 void unregisterObjectFromDBus(const QString &) noexcept
 {
 }
+
+bool writeFile(const QString &path, const QByteArray &content)
+{
+    QDir{}.mkpath(QFileInfo{path}.path());
+    QFile file{path};
+    return file.open(QFile::WriteOnly | QFile::Truncate) && file.write(content) == content.size();
+}
@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <QByteArray>
+#include <QString>
+
+// creates missing parent directories and replaces the file if it exists
+bool writeFile(const QString &path, const QByteArray &content = {});
+
+#endif